@@ -661,6 +661,13 @@
 
 #define MAX_CACHE_LINE_SIZE    U(0x800) /* 2KB */
 
+/*
+ * DCZID_EL0 definitions
+ */
+#define DCZID_BS_SHIFT        U(0)
+#define DCZID_BS_MASK        U(0xf)
+#define DCZID_DZP_BIT        (U(1) << 4)
+
 /* Physical timer control register bit fields shifts and masks */
 #define CNTP_CTL_ENABLE_SHIFT   U(0)
 #define CNTP_CTL_IMASK_SHIFT    U(1)
@@ -27,6 +27,13 @@
 **/
 uint32_t pal_printf(const char *msg, uint64_t data1, uint64_t data2);
 
+/**
+ *   @brief    - Transmits all buffered output and waits for the uart to go idle
+ *   @param    - void
+ *   @return   - void
+**/
+void pal_printf_flush(void);
+
 /**
  *   @brief    - Writes into given non-volatile address.
  *   @param    - offset  : Offset into nvmem
@@ -45,6 +52,37 @@ uint32_t pal_nvm_write(uint32_t offset, void *buffer, size_t size);
 **/
 uint32_t pal_nvm_read(uint32_t offset, void *buffer, size_t size);
 
+/* Non-volatile memory block descriptor for bulk transfers */
+typedef struct {
+    uint32_t offset;
+    void *buffer;
+    size_t size;
+} pal_nvm_block_ts;
+
+/**
+ *   @brief    - Writes a list of blocks into non-volatile memory.
+ *   @param    - blocks  : Block descriptor list
+ *   @param    - count   : Number of descriptors
+ *   @return   - SUCCESS/FAILURE
+**/
+uint32_t pal_nvm_write_blocks(pal_nvm_block_ts *blocks, uint32_t count);
+
+/**
+ *   @brief    - Reads a list of blocks from non-volatile memory.
+ *   @param    - blocks  : Block descriptor list
+ *   @param    - count   : Number of descriptors
+ *   @return   - SUCCESS/FAILURE
+**/
+uint32_t pal_nvm_read_blocks(pal_nvm_block_ts *blocks, uint32_t count);
+
+/**
+ *   @brief    - Measures and prints the non-volatile memory transfer rate
+ *               of the byte-wise and wide access paths.
+ *   @param    - void
+ *   @return   - SUCCESS/FAILURE
+**/
+uint32_t pal_nvm_benchmark(void);
+
 /**
  *   @brief    - Initializes and enable the hardware watchdog timer
  *   @param    - void
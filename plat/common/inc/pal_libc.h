@@ -44,5 +44,12 @@ void *pal_memcpy(void *dst, const void *src, size_t len);
 
 size_t pal_strlen(char *str);
 
+/**
+ * @brief        - Checks memcpy, memset and memcmp against byte-wise results,
+ *                 then prints their throughput next to byte-wise loops
+ * @return       - SUCCESS/FAILURE
+**/
+uint32_t pal_libc_benchmark(void);
+
 void pal_assert(const char *e, uint64_t line, const char *file);
 #endif
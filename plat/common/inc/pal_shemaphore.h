@@ -20,17 +20,27 @@ typedef struct {
      * the event hasn't been sent yet, or that all recipients have already
      * received it.
      *
-     * Volatile is needed as it will enforce ordering relatively to
-     * accesses to the lock.
+     * The counter is only updated with atomic instructions. Each event
+     * takes a cache line of its own so that arrays of events used by
+     * different CPUs do not share lines.
      */
     volatile unsigned int cnt;
+} __aligned(CACHE_WRITEBACK_GRANULE_PAL) event_t;
 
-    /* Lock used to avoid concurrent accesses to the counter */
-    s_lock_t lock;
-} event_t;
+typedef struct {
+    /* Number of CPUs that have reached the barrier in the current phase */
+    volatile unsigned int count;
+
+    /* Flipped by the last CPU to arrive, releasing the others */
+    volatile unsigned int sense;
+} __aligned(CACHE_WRITEBACK_GRANULE_PAL) barrier_t;
 
 void pal_init_spinlock(s_lock_t *lock);
 void pal_spin_lock(s_lock_t *lock);
 void pal_spin_unlock(s_lock_t *lock);
+void pal_shared_spin_lock(s_lock_t *lock);
+void pal_shared_spin_unlock(s_lock_t *lock);
+unsigned int pal_atomic_add(volatile unsigned int *addr, unsigned int val);
+unsigned int pal_atomic_cas(volatile unsigned int *addr, unsigned int old, unsigned int new);
 
 #endif /* _PAL_SHEMAPHORE_H_ */
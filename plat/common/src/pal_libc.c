@@ -40,13 +40,61 @@ size_t pal_strlen(char *str)
   return length;
 }
 
-/* Libc functions definition */
+/* Libc functions definition
+ *
+ * memcpy, memset and memcmp move 16 bytes per iteration as a pair of 64-bit
+ * words, which the compiler emits as LDP/STP. Word accesses are only issued
+ * once the pointers are 8-byte aligned, which keeps these routines safe with
+ * the MMU off, where every access is Device memory and must be aligned.
+ * Pointers with different offsets within a word are handled byte-wise.
+ */
+#define LIBC_WORD_SIZE    sizeof(uint64_t)
+#define LIBC_WORD_MASK    (LIBC_WORD_SIZE - 1)
+#define LIBC_IS_ALIGNED(p)    (((uint64_t)(p) & LIBC_WORD_MASK) == 0)
+
+/* Word view of an arbitrary buffer */
+typedef uint64_t __attribute__((__may_alias__)) libc_word_t;
 
 void *memcpy(void *dst, const void *src, size_t len)
 {
-    const char *s = src;
-    char *d = dst;
+    const unsigned char *s = src;
+    unsigned char *d = dst;
+    const libc_word_t *ws;
+    libc_word_t *wd, w0, w1;
+
+    if (LIBC_IS_ALIGNED((uint64_t)d ^ (uint64_t)s))
+    {
+        /* Byte-wise head up to the first word boundary */
+        while (len && !LIBC_IS_ALIGNED(d))
+        {
+            *d++ = *s++;
+            len--;
+        }
 
+        ws = (const void *)s;
+        wd = (void *)d;
+        while (len >= 2 * LIBC_WORD_SIZE)
+        {
+            w0 = ws[0];
+            w1 = ws[1];
+            wd[0] = w0;
+            wd[1] = w1;
+            ws += 2;
+            wd += 2;
+            len -= 2 * LIBC_WORD_SIZE;
+        }
+
+        if (len >= LIBC_WORD_SIZE)
+        {
+            *wd++ = *ws++;
+            len -= LIBC_WORD_SIZE;
+        }
+
+        s = (const void *)ws;
+        d = (void *)wd;
+    }
+
+    /* Byte-wise tail */
     while (len--)
     {
         *d++ = *s++;
@@ -58,7 +106,32 @@ void *memcpy(void *dst, const void *src, size_t len)
 void *memset(void *dst, int val, size_t count)
 {
     unsigned char *ptr = dst;
+    libc_word_t *wp, word;
+
+    while (count && !LIBC_IS_ALIGNED(ptr))
+    {
+        *ptr++ = (unsigned char)val;
+        count--;
+    }
+
+    /* Fill byte replicated across the word */
+    word = (uint64_t)(unsigned char)val * 0x0101010101010101ULL;
+    wp = (void *)ptr;
+    while (count >= 2 * LIBC_WORD_SIZE)
+    {
+        wp[0] = word;
+        wp[1] = word;
+        wp += 2;
+        count -= 2 * LIBC_WORD_SIZE;
+    }
+
+    if (count >= LIBC_WORD_SIZE)
+    {
+        *wp++ = word;
+        count -= LIBC_WORD_SIZE;
+    }
 
+    ptr = (void *)wp;
     while (count--)
     {
         *ptr++ = (unsigned char)val;
@@ -73,6 +146,32 @@ int memcmp(void *s1, void *s2, size_t len)
     unsigned char *d = s2;
     unsigned char sc;
     unsigned char dc;
+    libc_word_t *ws, *wd;
+
+    if (LIBC_IS_ALIGNED((uint64_t)s ^ (uint64_t)d))
+    {
+        while (len && !LIBC_IS_ALIGNED(s))
+        {
+            sc = *s++;
+            dc = *d++;
+            if (sc - dc)
+                return (sc - dc);
+            len--;
+        }
+
+        /* Skip equal words, the first differing word is resolved byte-wise */
+        ws = (void *)s;
+        wd = (void *)d;
+        while (len >= LIBC_WORD_SIZE && *ws == *wd)
+        {
+            ws++;
+            wd++;
+            len -= LIBC_WORD_SIZE;
+        }
+
+        s = (void *)ws;
+        d = (void *)wd;
+    }
 
     while (len--)
     {
@@ -101,6 +200,155 @@ void *memmove(void *dst, const void *src, size_t len)
         return dst;
 }
 
+/* Self check and benchmark buffers, word aligned */
+#define LIBC_BENCH_SIZE     0x800
+#define LIBC_BENCH_LOOPS    16
+#define LIBC_CHECK_LEN      40
+static uint64_t libc_bench_src[LIBC_BENCH_SIZE / LIBC_WORD_SIZE];
+static uint64_t libc_bench_dst[LIBC_BENCH_SIZE / LIBC_WORD_SIZE];
+
+/* Byte per iteration references, volatile keeps them from being widened */
+static void libc_copy8(void *dst, void *src, size_t len)
+{
+    volatile unsigned char *d = dst;
+    volatile unsigned char *s = src;
+
+    while (len--)
+        *d++ = *s++;
+}
+
+static void libc_fill8(void *dst, size_t len)
+{
+    volatile unsigned char *d = dst;
+
+    while (len--)
+        *d++ = 0x5A;
+}
+
+static void libc_cmp8(void *dst, void *src, size_t len)
+{
+    volatile unsigned char *d = dst;
+    volatile unsigned char *s = src;
+
+    while (len-- && *d++ == *s++)
+        ;
+}
+
+static void libc_copy(void *dst, void *src, size_t len)
+{
+    memcpy(dst, src, len);
+}
+
+static void libc_fill(void *dst, size_t len)
+{
+    memset(dst, 0x5A, len);
+}
+
+static void libc_cmp(void *dst, void *src, size_t len)
+{
+    (void)memcmp(dst, src, len);
+}
+
+/**
+ * @brief Checks memcpy, memset and memcmp against byte-wise results for every
+ *        source and destination offset within a word and short lengths.
+ * @return PAL_SUCCESS or PAL_ERROR on the first mismatch
+ */
+static uint32_t pal_libc_check(void)
+{
+    unsigned char *src = (void *)libc_bench_src;
+    unsigned char *dst = (void *)libc_bench_dst;
+    size_t soff, doff, len, i;
+    int ret;
+
+    for (i = 0; i < LIBC_BENCH_SIZE; i++)
+        src[i] = (unsigned char)(i * 7 + 1);
+
+    for (soff = 0; soff < LIBC_WORD_SIZE; soff++)
+    {
+        for (doff = 0; doff < LIBC_WORD_SIZE; doff++)
+        {
+            for (len = 0; len <= LIBC_CHECK_LEN; len++)
+            {
+                /* Guard bytes on both sides of the destination must survive */
+                for (i = 0; i < LIBC_CHECK_LEN + 2 * LIBC_WORD_SIZE; i++)
+                    dst[i] = 0xEE;
+
+                memcpy(dst + doff, src + soff, len);
+                for (i = 0; i < LIBC_CHECK_LEN + 2 * LIBC_WORD_SIZE; i++)
+                {
+                    if (dst[i] != ((i >= doff && i < doff + len) ?
+                                   src[soff + i - doff] : 0xEE))
+                        return PAL_ERROR;
+                }
+
+                if (memcmp(dst + doff, src + soff, len))
+                    return PAL_ERROR;
+
+                if (len)
+                {
+                    dst[doff + len - 1] ^= 0x80;
+                    ret = memcmp(dst + doff, src + soff, len);
+                    if ((dst[doff + len - 1] < src[soff + len - 1]) ? ret >= 0 : ret <= 0)
+                        return PAL_ERROR;
+                }
+
+                memset(dst + doff, (int)(0x100 + soff), len);
+                for (i = 0; i < LIBC_CHECK_LEN + 2 * LIBC_WORD_SIZE; i++)
+                {
+                    if (dst[i] != ((i >= doff && i < doff + len) ? soff : 0xEE))
+                        return PAL_ERROR;
+                }
+            }
+        }
+    }
+
+    return PAL_SUCCESS;
+}
+
+static uint64_t pal_libc_bench_run(void (*copy)(void *, void *, size_t),
+                                   void (*fill)(void *, size_t))
+{
+    uint64_t start, ticks;
+    uint32_t i;
+
+    start = syscounter_read();
+    for (i = 0; i < LIBC_BENCH_LOOPS; i++)
+    {
+        if (copy)
+            copy(libc_bench_dst, libc_bench_src, LIBC_BENCH_SIZE);
+        else
+            fill(libc_bench_dst, LIBC_BENCH_SIZE);
+    }
+    ticks = syscounter_read() - start;
+
+    /* Bytes per second, a zero tick run is reported as one tick */
+    return ((uint64_t)LIBC_BENCH_SIZE * LIBC_BENCH_LOOPS * read_cntfrq_el0()) /
+           (ticks ? ticks : 1);
+}
+
+uint32_t pal_libc_benchmark(void)
+{
+    if (pal_libc_check())
+    {
+        pal_printf("\tlibc self check failed\n", 0, 0);
+        return PAL_ERROR;
+    }
+
+    /* Equal buffers, memcmp walks the full length */
+    memcpy(libc_bench_dst, libc_bench_src, LIBC_BENCH_SIZE);
+
+    pal_printf("\tlibc benchmark, %d bytes\n", LIBC_BENCH_SIZE, 0);
+    pal_printf("\t  byte memcpy : %d bytes/s\n", pal_libc_bench_run(libc_copy8, NULL), 0);
+    pal_printf("\t  wide memcpy : %d bytes/s\n", pal_libc_bench_run(libc_copy, NULL), 0);
+    pal_printf("\t  byte memcmp : %d bytes/s\n", pal_libc_bench_run(libc_cmp8, NULL), 0);
+    pal_printf("\t  wide memcmp : %d bytes/s\n", pal_libc_bench_run(libc_cmp, NULL), 0);
+    pal_printf("\t  byte memset : %d bytes/s\n", pal_libc_bench_run(NULL, libc_fill8), 0);
+    pal_printf("\t  wide memset : %d bytes/s\n", pal_libc_bench_run(NULL, libc_fill), 0);
+
+    return PAL_SUCCESS;
+}
+
 /**
  * @brief Platform abstraction to handle assertion failures.
  *
@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "pal_interfaces.h"
+
+#if defined(SPIN_LOCK_MCS)
+/* MCS queued lock behind the s_lock_t API, built with -DSPIN_LOCK=MCS.
+ *
+ * The lock word holds the queue tail in bits [15:0] and the node of the
+ * holder in bits [31:16], both as node index + 1. Each waiter spins on its
+ * own node and the holder hands the lock to its successor on unlock. Nodes
+ * come from a pool claimed on lock and freed on unlock, so a CPU may hold
+ * several locks at once and no CPU index is needed.
+ *
+ * The node pool is private to the image, a lock taken by several images
+ * must use pal_shared_spin_lock instead.
+ */
+#define MCS_NODES_PER_CPU    4
+#define MCS_NODE_COUNT       (PLATFORM_CPU_COUNT * MCS_NODES_PER_CPU)
+
+#define MCS_TAIL(l)          ((volatile uint16_t *)(volatile void *)&(l)->lock)
+#define MCS_OWNER(l)         (MCS_TAIL(l) + 1)
+
+/* One node per cache line, waiters spin on their own line */
+typedef struct {
+    volatile uint32_t claimed;
+    volatile uint32_t locked;     /* Cleared by the predecessor on handover */
+    volatile uint32_t next;       /* Successor node index + 1, 0 for none */
+} __attribute__((aligned (64))) pal_mcs_node_ts;
+
+static pal_mcs_node_ts mcs_nodes[MCS_NODE_COUNT];
+
+/* Returns the previous value, the swap happened if it equals old */
+static inline uint32_t mcs_cas32_acquire(volatile uint32_t *addr, uint32_t old, uint32_t new)
+{
+    uint32_t val;
+#if defined(__ARM_FEATURE_ATOMICS)
+    val = old;
+    __asm__ volatile ("casa %w0, %w2, [%1]"
+                      : "+r" (val) : "r" (addr), "r" (new) : "memory");
+#else
+    uint32_t fail;
+
+    __asm__ volatile ("1: ldaxr %w0, [%2]\n"
+                      "   cmp   %w0, %w3\n"
+                      "   b.ne  2f\n"
+                      "   stxr  %w1, %w4, [%2]\n"
+                      "   cbnz  %w1, 1b\n"
+                      "2:"
+                      : "=&r" (val), "=&r" (fail)
+                      : "r" (addr), "r" (old), "r" (new) : "cc", "memory");
+#endif
+    return val;
+}
+
+static inline uint32_t mcs_swap16(volatile uint16_t *addr, uint32_t new)
+{
+    uint32_t val;
+#if defined(__ARM_FEATURE_ATOMICS)
+    __asm__ volatile ("swpalh %w2, %w0, [%1]"
+                      : "=&r" (val) : "r" (addr), "r" (new) : "memory");
+#else
+    uint32_t fail;
+
+    __asm__ volatile ("1: ldaxrh %w0, [%2]\n"
+                      "   stlxrh %w1, %w3, [%2]\n"
+                      "   cbnz   %w1, 1b\n"
+                      : "=&r" (val), "=&r" (fail)
+                      : "r" (addr), "r" (new) : "memory");
+#endif
+    return val;
+}
+
+static inline uint32_t mcs_cas16(volatile uint16_t *addr, uint32_t old, uint32_t new)
+{
+    uint32_t val;
+#if defined(__ARM_FEATURE_ATOMICS)
+    val = old;
+    __asm__ volatile ("casalh %w0, %w2, [%1]"
+                      : "+r" (val) : "r" (addr), "r" (new) : "memory");
+#else
+    uint32_t fail;
+
+    __asm__ volatile ("1: ldaxrh %w0, [%2]\n"
+                      "   cmp    %w0, %w3\n"
+                      "   b.ne   2f\n"
+                      "   stlxrh %w1, %w4, [%2]\n"
+                      "   cbnz   %w1, 1b\n"
+                      "2:"
+                      : "=&r" (val), "=&r" (fail)
+                      : "r" (addr), "r" (old), "r" (new) : "cc", "memory");
+#endif
+    return val;
+}
+
+static inline void mcs_store_release(volatile uint32_t *addr, uint32_t val)
+{
+    __asm__ volatile ("stlr %w1, [%0]" : : "r" (addr), "r" (val) : "memory");
+}
+
+/* Waits for *addr to change from val, the store changing it wakes the wfe */
+static inline uint32_t mcs_wait_while(volatile uint32_t *addr, uint32_t val)
+{
+    uint32_t cur;
+
+    __asm__ volatile ("   sevl\n"
+                      "1: wfe\n"
+                      "   ldaxr %w0, [%1]\n"
+                      "   cmp   %w0, %w2\n"
+                      "   b.eq  1b\n"
+                      : "=&r" (cur) : "r" (addr), "r" (val) : "cc", "memory");
+    return cur;
+}
+
+static uint32_t mcs_node_claim(void)
+{
+    uint64_t mpidr = read_mpidr_el1();
+    uint32_t i;
+
+    /* Start at a per cpu slot, claims only collide once those are in use */
+    i = (uint32_t)((((mpidr >> 8) & 0xFF) * 4 + (mpidr & 0xFF)) * MCS_NODES_PER_CPU %
+                   MCS_NODE_COUNT);
+
+    while (1)
+    {
+        if (!mcs_nodes[i].claimed && mcs_cas32_acquire(&mcs_nodes[i].claimed, 0, 1) == 0)
+            return i;
+
+        i = (i + 1) % MCS_NODE_COUNT;
+    }
+}
+
+void pal_init_spinlock(s_lock_t *lock)
+{
+    lock->lock = 0;
+}
+
+void pal_spin_lock(s_lock_t *lock)
+{
+    uint32_t node = mcs_node_claim();
+    uint32_t prev;
+
+    mcs_nodes[node].next = 0;
+    mcs_nodes[node].locked = 1;
+
+    /* Join the queue, the release orders the node set up before it */
+    prev = mcs_swap16(MCS_TAIL(lock), node + 1);
+    if (prev)
+    {
+        mcs_nodes[prev - 1].next = node + 1;
+        mcs_wait_while(&mcs_nodes[node].locked, 1);
+    }
+
+    *MCS_OWNER(lock) = (uint16_t)(node + 1);
+}
+
+void pal_spin_unlock(s_lock_t *lock)
+{
+    uint32_t node = (uint32_t)*MCS_OWNER(lock) - 1;
+    uint32_t next = mcs_nodes[node].next;
+
+    if (!next)
+    {
+        /* Last in queue, free the lock unless a CPU is joining right now */
+        if (mcs_cas16(MCS_TAIL(lock), node + 1, 0) == node + 1)
+        {
+            mcs_store_release(&mcs_nodes[node].claimed, 0);
+            return;
+        }
+
+        next = mcs_wait_while(&mcs_nodes[node].next, 0);
+    }
+
+    /* Hand over, the release makes the critical section visible to the successor */
+    mcs_store_release(&mcs_nodes[next - 1].locked, 0);
+    mcs_store_release(&mcs_nodes[node].claimed, 0);
+}
+#endif
@@ -11,4 +11,7 @@
 
 uint32_t pal_driver_nvm_write(uint32_t offset, void *buffer, size_t size);
 uint32_t pal_driver_nvm_read(uint32_t offset, void *buffer, size_t size);
+uint32_t pal_driver_nvm_write_blocks(pal_nvm_block_ts *blocks, uint32_t count);
+uint32_t pal_driver_nvm_read_blocks(pal_nvm_block_ts *blocks, uint32_t count);
+uint32_t pal_driver_nvm_benchmark(uint32_t offset, size_t size);
 #endif /* _PAL_NVM_H_ */
@@ -41,6 +41,8 @@ typedef struct {
 #define UART_PL011_UARTCR_TX_EN_MASK       (0x1u << UART_PL011_UARTCR_TXE_OFF)
 #define UART_PL011_UARTFR_TX_FIFO_FULL_OFF 0x5u
 #define UART_PL011_UARTFR_TX_FIFO_FULL     (0x1u << UART_PL011_UARTFR_TX_FIFO_FULL_OFF)
+#define UART_PL011_UARTFR_BUSY_OFF         0x3u
+#define UART_PL011_UARTFR_BUSY             (0x1u << UART_PL011_UARTFR_BUSY_OFF)
 
 #define UART_PL011_INTR_TX_OFF             0x5u
 #define UART_PL011_TX_INTR_MASK            (0x1u << UART_PL011_INTR_TX_OFF)
@@ -54,7 +56,11 @@ typedef struct {
 
 #define PLATFORM_UART_BASE PLATFORM_NS_UART_BASE
 
+/* Software TX ring in front of the PL011 FIFO, must be a power of two */
+#define UART_PL011_TX_RING_SIZE  0x1000
+
 /* function prototypes */
 extern void pal_driver_uart_pl011_putc(uint8_t c);
+extern void pal_driver_uart_pl011_flush(void);
 
 #endif /* _PAL_UART_PL011_H_ */
@@ -10,7 +10,14 @@
 
 static addr_t nvm_base = PLATFORM_NVM_BASE;
 
-uint32_t pal_driver_nvm_write(uint32_t offset, void *buffer, size_t size)
+#define NVM_WORD_SIZE     sizeof(uint64_t)
+#define NVM_IS_ALIGNED(x, a)   (((uint64_t)(x) & ((a) - 1)) == 0)
+
+/* Bounce buffer for the microbenchmark, sized for the largest supported window */
+#define NVM_BENCH_MAX_SIZE    0x1000
+static uint8_t nvm_bench_buf[NVM_BENCH_MAX_SIZE];
+
+static uint32_t pal_driver_nvm_write8(uint32_t offset, void *buffer, size_t size)
 {
     size_t b_cnt;
 
@@ -22,7 +29,7 @@ uint32_t pal_driver_nvm_write(uint32_t offset, void *buffer, size_t size)
     return PAL_SUCCESS;
 }
 
-uint32_t pal_driver_nvm_read(uint32_t offset, void *buffer, size_t size)
+static uint32_t pal_driver_nvm_read8(uint32_t offset, void *buffer, size_t size)
 {
     size_t b_cnt;
 
@@ -33,3 +40,140 @@ uint32_t pal_driver_nvm_read(uint32_t offset, void *buffer, size_t size)
 
     return PAL_SUCCESS;
 }
+
+uint32_t pal_driver_nvm_write(uint32_t offset, void *buffer, size_t size)
+{
+    uint64_t addr = nvm_base + offset, data64;
+    uint32_t data32;
+    uint8_t *src = (uint8_t *)buffer;
+
+    /* Byte-wise head up to the first device word boundary */
+    while (size && !NVM_IS_ALIGNED(addr, NVM_WORD_SIZE))
+    {
+        pal_mmio_write8(addr++, *src++);
+        size--;
+    }
+
+    /* Aligned 64-bit body, source buffer may be unaligned */
+    while (size >= NVM_WORD_SIZE)
+    {
+        pal_memcpy(&data64, src, NVM_WORD_SIZE);
+        pal_mmio_write64(addr, data64);
+        addr += NVM_WORD_SIZE;
+        src += NVM_WORD_SIZE;
+        size -= NVM_WORD_SIZE;
+    }
+
+    if (size >= sizeof(uint32_t))
+    {
+        pal_memcpy(&data32, src, sizeof(uint32_t));
+        pal_mmio_write32(addr, data32);
+        addr += sizeof(uint32_t);
+        src += sizeof(uint32_t);
+        size -= sizeof(uint32_t);
+    }
+
+    /* Byte-wise tail */
+    while (size--)
+        pal_mmio_write8(addr++, *src++);
+
+    return PAL_SUCCESS;
+}
+
+uint32_t pal_driver_nvm_read(uint32_t offset, void *buffer, size_t size)
+{
+    uint64_t addr = nvm_base + offset, data64;
+    uint32_t data32;
+    uint8_t *dst = (uint8_t *)buffer;
+
+    /* Byte-wise head up to the first device word boundary */
+    while (size && !NVM_IS_ALIGNED(addr, NVM_WORD_SIZE))
+    {
+        *dst++ = pal_mmio_read8(addr++);
+        size--;
+    }
+
+    /* Aligned 64-bit body, destination buffer may be unaligned */
+    while (size >= NVM_WORD_SIZE)
+    {
+        data64 = pal_mmio_read64(addr);
+        pal_memcpy(dst, &data64, NVM_WORD_SIZE);
+        addr += NVM_WORD_SIZE;
+        dst += NVM_WORD_SIZE;
+        size -= NVM_WORD_SIZE;
+    }
+
+    if (size >= sizeof(uint32_t))
+    {
+        data32 = pal_mmio_read32(addr);
+        pal_memcpy(dst, &data32, sizeof(uint32_t));
+        addr += sizeof(uint32_t);
+        dst += sizeof(uint32_t);
+        size -= sizeof(uint32_t);
+    }
+
+    /* Byte-wise tail */
+    while (size--)
+        *dst++ = pal_mmio_read8(addr++);
+
+    return PAL_SUCCESS;
+}
+
+uint32_t pal_driver_nvm_write_blocks(pal_nvm_block_ts *blocks, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (pal_driver_nvm_write(blocks[i].offset, blocks[i].buffer, blocks[i].size))
+            return PAL_ERROR;
+    }
+
+    return PAL_SUCCESS;
+}
+
+uint32_t pal_driver_nvm_read_blocks(pal_nvm_block_ts *blocks, uint32_t count)
+{
+    uint32_t i;
+
+    for (i = 0; i < count; i++)
+    {
+        if (pal_driver_nvm_read(blocks[i].offset, blocks[i].buffer, blocks[i].size))
+            return PAL_ERROR;
+    }
+
+    return PAL_SUCCESS;
+}
+
+static uint64_t pal_driver_nvm_bench_run(uint32_t (*fn)(uint32_t, void *, size_t),
+                                         uint32_t offset, size_t size)
+{
+    uint64_t start, ticks;
+
+    start = syscounter_read();
+    fn(offset, nvm_bench_buf, size);
+    ticks = syscounter_read() - start;
+
+    /* Bytes per second, a zero tick run is reported as one tick */
+    return ((uint64_t)size * read_cntfrq_el0()) / (ticks ? ticks : 1);
+}
+
+uint32_t pal_driver_nvm_benchmark(uint32_t offset, size_t size)
+{
+    if (size > NVM_BENCH_MAX_SIZE || (offset + size) > PLATFORM_NVM_SIZE)
+        return PAL_ERROR;
+
+    pal_memset(nvm_bench_buf, 0xA5, size);
+
+    pal_printf("\tNVM benchmark, %d bytes\n", size, 0);
+    pal_printf("\t  byte write : %d bytes/s\n",
+               pal_driver_nvm_bench_run(pal_driver_nvm_write8, offset, size), 0);
+    pal_printf("\t  wide write : %d bytes/s\n",
+               pal_driver_nvm_bench_run(pal_driver_nvm_write, offset, size), 0);
+    pal_printf("\t  byte read  : %d bytes/s\n",
+               pal_driver_nvm_bench_run(pal_driver_nvm_read8, offset, size), 0);
+    pal_printf("\t  wide read  : %d bytes/s\n",
+               pal_driver_nvm_bench_run(pal_driver_nvm_read, offset, size), 0);
+
+    return PAL_SUCCESS;
+}
@@ -10,6 +10,14 @@
 static volatile uint64_t g_uart = PLATFORM_UART_BASE;
 static uint8_t is_uart_init_done;
 
+/* TX ring, head is the next free slot and tail the next char to transmit */
+static struct {
+    uint8_t buf[UART_PL011_TX_RING_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    s_lock_t lock;
+} tx_ring;
+
 /**
  *   @brief    - This function initializes the UART
  *   @param    - uart_base_addr: Base address of UART
@@ -60,13 +68,57 @@ static int pal_driver_uart_pl011_is_tx_empty(void)
 }
 
 /**
- *   @brief    - This function checks for empty TX FIFO and writes to FIFO register
+ *   @brief    - Returns true once the stage 1 MMU is on, exclusive accesses used
+ *               by the ring lock are not reliable on Device memory before that.
+ *               Only the boot cpu runs at that point so no lock is needed.
+ *   @param    - none
+ *   @return   - true/false
+**/
+static bool pal_driver_uart_pl011_can_lock(void)
+{
+    uint64_t sctlr = (get_current_el() == 2) ? read_sctlr_el2() : read_sctlr_el1();
+
+    return (sctlr & SCTLR_ELx_M_BIT) != 0;
+}
+
+/**
+ *   @brief    - Moves chars from the TX ring into the PL011 FIFO
+ *   @param    - wait: Number of chars to transmit even if the FIFO is full,
+ *               remaining chars are only written while the FIFO has room
+ *   @return   - none
+**/
+static void pal_driver_uart_pl011_drain(uint32_t wait)
+{
+    while (tx_ring.tail != tx_ring.head)
+    {
+        if (!pal_driver_uart_pl011_is_tx_empty())
+        {
+            if (!wait)
+                break;
+            continue;
+        }
+
+        /* write the data (upper 24 bits are reserved) */
+        ((pal_uart_t *)g_uart)->uartdr = tx_ring.buf[tx_ring.tail & (UART_PL011_TX_RING_SIZE - 1)];
+        tx_ring.tail++;
+        if (wait)
+            wait--;
+    }
+}
+
+/**
+ *   @brief    - This function queues a char into the TX ring and drains the
+ *               ring into the TX FIFO as far as the FIFO has room. It only
+ *               waits for the UART when the ring is full.
  *   @param    - char to be written
  *   @return   - none
 **/
 void pal_driver_uart_pl011_putc(uint8_t c)
 {
-    const uint8_t pdata = (uint8_t)c;
+    bool locked = pal_driver_uart_pl011_can_lock();
+
+    if (locked)
+        pal_spin_lock(&tx_ring.lock);
 
     if (is_uart_init_done == 0)
     {
@@ -74,10 +126,44 @@ void pal_driver_uart_pl011_putc(uint8_t c)
         is_uart_init_done = 1;
     }
 
-    /* ensure TX buffer to be empty */
-    while (!pal_driver_uart_pl011_is_tx_empty())
-      ;
+    /* Ring full, make room for one char */
+    if ((tx_ring.head - tx_ring.tail) == UART_PL011_TX_RING_SIZE)
+        pal_driver_uart_pl011_drain(1);
+
+    tx_ring.buf[tx_ring.head & (UART_PL011_TX_RING_SIZE - 1)] = c;
+    tx_ring.head++;
+
+    /* Opportunistic burst into the FIFO, never waits */
+    pal_driver_uart_pl011_drain(0);
+
+    if (locked)
+        pal_spin_unlock(&tx_ring.lock);
+}
+
+/**
+ *   @brief    - This function transmits every queued char and waits for the
+ *               UART to go idle. Must be called before the system stops or
+ *               resets, otherwise queued output is lost.
+ *   @param    - none
+ *   @return   - none
+**/
+void pal_driver_uart_pl011_flush(void)
+{
+    bool locked;
+
+    /* Nothing was ever printed, the UART may not even be mapped */
+    if (is_uart_init_done == 0)
+        return;
+
+    locked = pal_driver_uart_pl011_can_lock();
+    if (locked)
+        pal_spin_lock(&tx_ring.lock);
+
+    pal_driver_uart_pl011_drain(UART_PL011_TX_RING_SIZE);
+
+    while (((pal_uart_t *)g_uart)->uartfr & UART_PL011_UARTFR_BUSY)
+        ;
 
-    /* write the data (upper 24 bits are reserved) */
-    ((pal_uart_t *)g_uart)->uartdr = pdata;
+    if (locked)
+        pal_spin_unlock(&tx_ring.lock);
 }
@@ -19,6 +19,7 @@ set(PAL_SRC
     ${ROOT_DIR}/plat/common/src/pal_libc.c
     ${ROOT_DIR}/plat/common/src/pal_syscall.S
     ${ROOT_DIR}/plat/common/src/pal_spinlock.S
+    ${ROOT_DIR}/plat/common/src/pal_spinlock_mcs.c
     ${ROOT_DIR}/plat/driver/src/gic/pal_arm_gic_v3.c
     ${ROOT_DIR}/plat/driver/src/gic/pal_gic_common.c
     ${ROOT_DIR}/plat/driver/src/gic/pal_gic_v3.c
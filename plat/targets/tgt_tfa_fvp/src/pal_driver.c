@@ -70,6 +70,11 @@ uint32_t pal_printf(const char *msg, uint64_t data1, uint64_t data2)
     return PAL_SUCCESS;
 }
 
+void pal_printf_flush(void)
+{
+    pal_driver_uart_pl011_flush();
+}
+
 uint32_t pal_nvm_write(uint32_t offset, void *buffer, size_t size)
 {
     return pal_driver_nvm_write(offset, buffer, size);
@@ -80,6 +85,22 @@ uint32_t pal_nvm_read(uint32_t offset, void *buffer, size_t size)
     return pal_driver_nvm_read(offset, buffer, size);
 }
 
+uint32_t pal_nvm_write_blocks(pal_nvm_block_ts *blocks, uint32_t count)
+{
+    return pal_driver_nvm_write_blocks(blocks, count);
+}
+
+uint32_t pal_nvm_read_blocks(pal_nvm_block_ts *blocks, uint32_t count)
+{
+    return pal_driver_nvm_read_blocks(blocks, count);
+}
+
+uint32_t pal_nvm_benchmark(void)
+{
+    /* Scratch window in the upper half of NVM, clear of the ACS state */
+    return pal_driver_nvm_benchmark(PLATFORM_NVM_SIZE / 2, 0x1000);
+}
+
 uint32_t pal_watchdog_enable(void)
 {
     pal_driver_sp805_wdog_start(PLATFORM_WDOG_BASE);
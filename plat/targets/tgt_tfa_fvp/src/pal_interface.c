@@ -9,6 +9,8 @@
 
 uint32_t pal_terminate_simulation(void)
 {
+   /* Buffered uart output is lost once the cpu stops */
+   pal_printf_flush();
    asm volatile("wfi" : : : "memory");
    return PAL_SUCCESS;
 }
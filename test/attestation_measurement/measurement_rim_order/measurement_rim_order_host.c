@@ -105,7 +105,7 @@ void measurement_rim_order_host(void)
         goto destroy_realm;
     }
 
-    val_memset((void *)src1, 0x0, PAGE_SIZE);
+    val_zero_granule((void *)src1);
 
     uint64_t flags1 = RMI_MEASURE_CONTENT;
 
@@ -175,7 +175,7 @@ void measurement_rim_order_host(void)
         goto destroy_realm;
     }
 
-    val_memset((void *)src2, 0x0, PAGE_SIZE);
+    val_zero_granule((void *)src2);
 
     uint64_t flags2 = RMI_MEASURE_CONTENT;
 
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#include "test_database.h"
+#include "val_host_rmi.h"
+#include "val_host_realm.h"
+#include "val_timer.h"
+#include "pal.h"
+
+/* Granules delegated by each cpu per pass, and passes per round */
+#define BENCH_GRANULES          64
+#define BENCH_PASSES            4
+#define BENCH_SAMPLES           (BENCH_GRANULES * BENCH_PASSES)
+#define BENCH_BLOCK_SIZE        VAL_RTT_L2_BLOCK_SIZE
+#define BENCH_BLOCK_GRANULES    (BENCH_BLOCK_SIZE / PAGE_SIZE)
+#define BENCH_L1_REGION_SHIFT   VAL_RTT_LEVEL_SHIFT(1)
+/* 2MB blocks tried when looking for distinct 1GB regions */
+#define BENCH_MAX_BLOCKS        24
+
+#ifndef SECURE_TEST_ENABLE
+typedef enum {
+    BENCH_SAME_2MB = 0,     /* All cpus in one 2MB block */
+    BENCH_OWN_2MB,          /* One 2MB block per cpu */
+    BENCH_OWN_1GB,          /* One 2MB block per cpu, each in its own 1GB region */
+    BENCH_LAYOUT_COUNT
+} bench_layout_te;
+
+typedef struct {
+    uint64_t base;          /* Base of the 2MB block holding the granules */
+    uint64_t first;         /* Index of the first granule in the block */
+    uint64_t stride;        /* Granules between two consecutive PAs */
+} bench_job_ts;
+
+static bench_job_ts job[PLATFORM_CPU_COUNT];
+static uint64_t granule_count;
+static uint64_t delegate_lat[PLATFORM_CPU_COUNT][BENCH_SAMPLES];
+static uint64_t delegate_ticks[PLATFORM_CPU_COUNT];
+static uint64_t undelegate_ticks[PLATFORM_CPU_COUNT];
+static uint64_t sorted_lat[PLATFORM_CPU_COUNT * BENCH_SAMPLES];
+static val_host_future_ts cpu_done[PLATFORM_CPU_COUNT];
+static barrier_t round_start;
+static volatile uint32_t round_cpus;
+static uint64_t block[BENCH_MAX_BLOCKS];
+
+/*
+ * The granule tracker behind val_host_rmi_granule_delegate is not MP safe,
+ * so the benchmark issues the commands directly and undelegates every
+ * granule it delegated.
+ */
+static uint64_t bench_delegate(uint64_t pa)
+{
+    return val_smc_call(RMI_GRANULE_DELEGATE, pa, 0, 0, 0, 0, 0, 0, 0, 0, 0).x0;
+}
+
+static uint64_t bench_undelegate(uint64_t pa)
+{
+    return val_smc_call(RMI_GRANULE_UNDELEGATE, pa, 0, 0, 0, 0, 0, 0, 0, 0, 0).x0;
+}
+
+static uint64_t bench_granule_pa(bench_job_ts *cpu_job, uint64_t i)
+{
+    return cpu_job->base + (cpu_job->first + i * cpu_job->stride) * PAGE_SIZE;
+}
+
+/* Runs the passes of the cpu given by arg, its job is set up by the primary */
+static uint64_t bench_delegate_worker(uint64_t arg)
+{
+    bench_job_ts *cpu_job = &job[arg];
+    uint64_t pass, i, j, start, lat, ret;
+
+    delegate_ticks[arg] = 0;
+    undelegate_ticks[arg] = 0;
+
+    val_barrier_wait(&round_start, round_cpus);
+
+    for (pass = 0; pass < BENCH_PASSES; pass++)
+    {
+        for (i = 0; i < granule_count; i++)
+        {
+            start = val_read_cntpct_el0();
+            ret = bench_delegate(bench_granule_pa(cpu_job, i));
+            lat = val_read_cntpct_el0() - start;
+            if (ret)
+            {
+                LOG(ERROR, "\tDelegate failed, pa=%x ret=%x\n", bench_granule_pa(cpu_job, i), ret);
+                /* Leave no granule of this pass in Realm PAS */
+                for (j = 0; j < i; j++)
+                    (void)bench_undelegate(bench_granule_pa(cpu_job, j));
+                return VAL_ERROR;
+            }
+
+            delegate_lat[arg][pass * granule_count + i] = lat;
+            delegate_ticks[arg] += lat;
+        }
+
+        start = val_read_cntpct_el0();
+        for (i = 0; i < granule_count; i++)
+        {
+            ret = bench_undelegate(bench_granule_pa(cpu_job, i));
+            if (ret)
+            {
+                LOG(ERROR, "\tUndelegate failed, pa=%x ret=%x\n", bench_granule_pa(cpu_job, i), ret);
+                return VAL_ERROR;
+            }
+        }
+        undelegate_ticks[arg] += val_read_cntpct_el0() - start;
+    }
+
+    return VAL_SUCCESS;
+}
+
+static void bench_sort(uint64_t *lat, uint64_t count)
+{
+    uint64_t i, j, v;
+
+    for (i = 1; i < count; i++)
+    {
+        v = lat[i];
+        for (j = i; j > 0 && lat[j - 1] > v; j--)
+            lat[j] = lat[j - 1];
+        lat[j] = v;
+    }
+}
+
+/* Prints throughput and delegate latency percentiles of a round on n cpus */
+static void bench_report(uint32_t n)
+{
+    uint64_t i, count = 0, delegations = 0, undelegations = 0;
+    uint64_t freq = val_read_cntfrq_el0();
+
+    for (i = 0; i < n; i++)
+    {
+        delegations += (granule_count * BENCH_PASSES * freq) /
+                       (delegate_ticks[i] ? delegate_ticks[i] : 1);
+        undelegations += (granule_count * BENCH_PASSES * freq) /
+                         (undelegate_ticks[i] ? undelegate_ticks[i] : 1);
+
+        val_memcpy(&sorted_lat[count], delegate_lat[i],
+                   granule_count * BENCH_PASSES * sizeof(uint64_t));
+        count += granule_count * BENCH_PASSES;
+    }
+
+    bench_sort(sorted_lat, count);
+
+    LOG(ALWAYS, "\tcpus %d : %d delegations/s\n", n, delegations);
+    LOG(ALWAYS, "\tcpus %d : %d undelegations/s\n", n, undelegations);
+    LOG(ALWAYS, "\t  delegate p50 %d, p90 %d ticks\n",
+        sorted_lat[count / 2], sorted_lat[(count * 9) / 10]);
+    LOG(ALWAYS, "\t  delegate p99 %d, max %d ticks\n",
+        sorted_lat[(count * 99) / 100], sorted_lat[count - 1]);
+}
+
+/* Returns the number of 2MB blocks in block[], 0 if the layout can not be set up */
+static uint32_t bench_alloc_blocks(bench_layout_te layout, uint32_t cpu_count)
+{
+    uint32_t blocks = 0, chosen = 0, i, j;
+    uint32_t need = (layout == BENCH_SAME_2MB) ? 1 : cpu_count;
+    bool taken;
+
+    while (chosen < need && blocks < BENCH_MAX_BLOCKS)
+    {
+        block[blocks] = (uint64_t)val_host_mem_alloc(BENCH_BLOCK_SIZE, BENCH_BLOCK_SIZE);
+        if (!block[blocks])
+            break;
+
+        /* Keep the block first when its 1GB region is new, else park it at the end */
+        taken = false;
+        for (j = 0; layout == BENCH_OWN_1GB && j < chosen; j++)
+        {
+            if ((block[j] >> BENCH_L1_REGION_SHIFT) ==
+                (block[blocks] >> BENCH_L1_REGION_SHIFT))
+                taken = true;
+        }
+
+        if (!taken)
+        {
+            uint64_t tmp = block[chosen];
+
+            block[chosen] = block[blocks];
+            block[blocks] = tmp;
+            chosen++;
+        }
+        blocks++;
+    }
+
+    /* Blocks past the chosen ones are only in the way, all are when too few were found */
+    if (chosen != need)
+        chosen = 0;
+
+    for (i = chosen; i < blocks; i++)
+        val_host_mem_free((void *)block[i]);
+
+    return chosen;
+}
+#endif
+
+void bench_granule_delegate_host(void)
+{
+#ifdef SECURE_TEST_ENABLE
+    /* Secure infrasturcure does not support MP boot yet, hence skipping the test */
+    val_set_status(RESULT_SKIP(VAL_SKIP_CHECK));
+    goto exit;
+#else
+    uint64_t ret;
+    uint32_t i, n, cpu, cpu_count, primary_cpuid, blocks, layout, scattered;
+    uint32_t cpu_of[PLATFORM_CPU_COUNT];
+
+    primary_cpuid = val_get_cpuid(val_read_mpidr() & PAL_MPIDR_AFFINITY_MASK);
+    cpu_count = val_get_cpu_count();
+    if (cpu_count > PLATFORM_CPU_COUNT)
+        cpu_count = PLATFORM_CPU_COUNT;
+
+    /* Job i runs on the i-th cpu of the round, the primary always takes job 0 */
+    cpu_of[0] = primary_cpuid;
+    for (i = 0, n = 1; i < cpu_count; i++)
+    {
+        if (i != primary_cpuid)
+            cpu_of[n++] = i;
+    }
+
+    for (layout = 0; layout < BENCH_LAYOUT_COUNT; layout++)
+    {
+        blocks = bench_alloc_blocks((bench_layout_te)layout, cpu_count);
+        if (blocks == 0)
+        {
+            if (layout == BENCH_OWN_1GB)
+            {
+                /* The heap rarely spans one 1GB region per cpu */
+                LOG(ALWAYS, "\tNo distinct 1GB region per cpu, layout skipped\n", 0, 0);
+                continue;
+            }
+
+            LOG(ERROR, "\tUnable to allocate 2MB blocks\n", 0, 0);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+            goto exit;
+        }
+
+        for (scattered = 0; scattered < 2; scattered++)
+        {
+            if (layout == BENCH_SAME_2MB)
+            {
+                LOG(ALWAYS, "\tAll cpus in one 2MB block", 0, 0);
+            } else if (layout == BENCH_OWN_2MB)
+            {
+                LOG(ALWAYS, "\tOne 2MB block per cpu", 0, 0);
+            } else {
+                LOG(ALWAYS, "\tOne 2MB block per cpu in its own 1GB region", 0, 0);
+            }
+            if (scattered)
+            {
+                LOG(ALWAYS, ", scattered PAs\n", 0, 0);
+            } else {
+                LOG(ALWAYS, ", contiguous PAs\n", 0, 0);
+            }
+
+            for (n = 1; n <= cpu_count; n++)
+            {
+                /* A shared block is split between the cpus of the round */
+                granule_count = BENCH_GRANULES;
+                if (layout == BENCH_SAME_2MB && granule_count * n > BENCH_BLOCK_GRANULES)
+                    granule_count = BENCH_BLOCK_GRANULES / n;
+
+                for (i = 0; i < n; i++)
+                {
+                    if (layout == BENCH_SAME_2MB)
+                    {
+                        /* Scattered cpus interleave granule by granule */
+                        job[i].base = block[0];
+                        job[i].first = scattered ? i : i * granule_count;
+                        job[i].stride = scattered ? n : 1;
+                    } else {
+                        job[i].base = block[i];
+                        job[i].first = 0;
+                        job[i].stride = scattered ? BENCH_BLOCK_GRANULES / granule_count : 1;
+                    }
+                }
+
+                round_cpus = n;
+                val_init_barrier(&round_start);
+
+                for (i = 1; i < n; i++)
+                {
+                    cpu = cpu_of[i];
+                    ret = val_host_park_cpu(cpu);
+                    if (ret == VAL_SUCCESS)
+                        ret = val_host_post_work(cpu, bench_delegate_worker, i, &cpu_done[cpu]);
+
+                    if (ret != VAL_SUCCESS)
+                    {
+                        LOG(ERROR, "\tUnable to run on cpu mpidr 0x%x, ret=%x\n",
+                                            val_get_mpidr(cpu), ret);
+                        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+
+                        /* Stand in for the cpus not started, releasing the started ones */
+                        for (cpu = i; cpu <= n; cpu++)
+                            val_barrier_arrive(&round_start, n);
+
+                        while (--i > 0)
+                            (void)val_host_wait_future(&cpu_done[cpu_of[i]]);
+                        goto exit;
+                    }
+                }
+
+                ret = bench_delegate_worker(0);
+                for (i = 1; i < n; i++)
+                {
+                    if (val_host_wait_future(&cpu_done[cpu_of[i]]) != VAL_SUCCESS)
+                        ret = VAL_ERROR;
+                }
+
+                if (ret != VAL_SUCCESS)
+                {
+                    val_set_status(RESULT_FAIL(VAL_ERROR_POINT(3)));
+                    goto exit;
+                }
+
+                bench_report(n);
+            }
+        }
+
+        for (i = 0; i < blocks; i++)
+            val_host_mem_free((void *)block[i]);
+    }
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+#endif
+exit:
+    return;
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#include "test_database.h"
+#include "val_host_rmi.h"
+#include "val_host_realm.h"
+#include "val_timer.h"
+#include "pal.h"
+
+/* REC entries timed by each cpu in a round */
+#define BENCH_EXITS         0x400
+/* Set in gprs[0] of the REC entry to end the realm exit loop */
+#define BENCH_STOP          1
+/* Returned by a cpu whose loop hit an unexpected exit */
+#define BENCH_FAILED        (~0ULL)
+
+#ifndef SECURE_TEST_ENABLE
+/* One single REC realm per cpu, each only ever entered from its own cpu */
+static val_host_realm_ts realm[PLATFORM_CPU_COUNT];
+static val_host_future_ts cpu_done[PLATFORM_CPU_COUNT];
+static barrier_t round_start;
+static volatile uint32_t round_cpus;
+
+/* Enters REC[0] of the realm once and checks that it came back with a host call */
+static uint64_t bench_rec_enter(val_host_realm_ts *bench_realm, uint64_t stop)
+{
+    val_host_rec_run_ts *run = (val_host_rec_run_ts *)bench_realm->run[0];
+    uint64_t ret;
+
+    run->enter.gprs[0] = stop;
+    ret = val_host_rmi_rec_enter(bench_realm->rec[0], bench_realm->run[0]);
+    if (ret)
+    {
+        LOG(ERROR, "\tRec enter failed, ret=%x\n", ret, 0);
+        return VAL_ERROR;
+    }
+
+    if (val_host_check_realm_exit_host_call(run))
+    {
+        LOG(ERROR, "\tUnexpected REC exit, reason=%x\n", run->exit.exit_reason, 0);
+        return VAL_ERROR;
+    }
+
+    return VAL_SUCCESS;
+}
+
+/* Times BENCH_EXITS entry/exit round trips of the realm given by arg */
+static uint64_t bench_rec_enter_worker(uint64_t arg)
+{
+    uint64_t i, start;
+
+    val_barrier_wait(&round_start, round_cpus);
+
+    start = val_read_cntpct_el0();
+    for (i = 0; i < BENCH_EXITS; i++)
+    {
+        if (bench_rec_enter(&realm[arg], 0))
+            return BENCH_FAILED;
+    }
+
+    return val_read_cntpct_el0() - start;
+}
+#endif
+
+void bench_rec_enter_scaling_host(void)
+{
+#ifdef SECURE_TEST_ENABLE
+    /* Secure infrasturcure does not support MP boot yet, hence skipping the test */
+    val_set_status(RESULT_SKIP(VAL_SKIP_CHECK));
+    goto exit;
+#else
+    uint64_t ret, ticks, rate, sum, slowest;
+    uint32_t i, n, cpu, cpu_count, primary_cpuid;
+    uint32_t cpu_of[PLATFORM_CPU_COUNT];
+    bool failed;
+
+    primary_cpuid = val_get_cpuid(val_read_mpidr() & PAL_MPIDR_AFFINITY_MASK);
+    cpu_count = val_get_cpu_count();
+    if (cpu_count > PLATFORM_CPU_COUNT)
+        cpu_count = PLATFORM_CPU_COUNT;
+
+    /* Realm i runs on the i-th cpu of the round, the primary always takes realm 0 */
+    cpu_of[0] = primary_cpuid;
+    for (i = 0, n = 1; i < cpu_count; i++)
+    {
+        if (i != primary_cpuid)
+            cpu_of[n++] = i;
+    }
+
+    for (i = 0; i < cpu_count; i++)
+    {
+        val_memset(&realm[i], 0, sizeof(realm[i]));
+        val_host_realm_params(&realm[i]);
+
+        if (val_host_realm_setup(&realm[i], 1))
+        {
+            /* Scale up to the cpus that got a realm */
+            LOG(WARN, "\tRealm setup failed, running on %d cpus\n", i, 0);
+            cpu_count = i;
+            break;
+        }
+
+        /* First entry runs the realm up to its first host call */
+        if (bench_rec_enter(&realm[i], 0))
+        {
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+            goto exit;
+        }
+    }
+
+    if (cpu_count == 0)
+    {
+        LOG(ERROR, "\tRealm setup failed\n", 0, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+        goto exit;
+    }
+
+    for (n = 1; n <= cpu_count; n++)
+    {
+        round_cpus = n;
+        val_init_barrier(&round_start);
+
+        for (i = 1; i < n; i++)
+        {
+            cpu = cpu_of[i];
+            ret = val_host_park_cpu(cpu);
+            if (ret == VAL_SUCCESS)
+                ret = val_host_post_work(cpu, bench_rec_enter_worker, i, &cpu_done[cpu]);
+
+            if (ret != VAL_SUCCESS)
+            {
+                LOG(ERROR, "\tUnable to run on cpu mpidr 0x%x, ret=%x\n", val_get_mpidr(cpu), ret);
+                val_set_status(RESULT_FAIL(VAL_ERROR_POINT(3)));
+
+                /* Stand in for the cpus not started, releasing the started ones */
+                for (cpu = i; cpu <= n; cpu++)
+                    val_barrier_arrive(&round_start, n);
+
+                while (--i > 0)
+                    (void)val_host_wait_future(&cpu_done[cpu_of[i]]);
+                goto exit;
+            }
+        }
+
+        ticks = bench_rec_enter_worker(0);
+        sum = 0;
+        slowest = 0;
+        failed = false;
+
+        /* Every cpu is waited for, one that failed does not stop the others */
+        for (i = 0; i < n; i++)
+        {
+            if (i != 0)
+                ticks = val_host_wait_future(&cpu_done[cpu_of[i]]);
+
+            if (ticks == BENCH_FAILED)
+            {
+                failed = true;
+                continue;
+            }
+
+            rate = (BENCH_EXITS * val_read_cntfrq_el0()) / (ticks ? ticks : 1);
+            sum += rate;
+            if (i == 0 || rate < slowest)
+                slowest = rate;
+        }
+
+        if (failed)
+        {
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(4)));
+            goto exit;
+        }
+
+        LOG(ALWAYS, "\tcpus %d : %d exits/s per cpu\n", n, sum / n);
+        LOG(ALWAYS, "\tcpus %d : %d exits/s on the slowest cpu\n", n, slowest);
+    }
+
+    /* Let every realm finish its test before the framework tears it down */
+    for (i = 0; i < cpu_count; i++)
+    {
+        if (bench_rec_enter(&realm[i], BENCH_STOP))
+        {
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(5)));
+            goto exit;
+        }
+    }
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+#endif
+exit:
+    return;
+}
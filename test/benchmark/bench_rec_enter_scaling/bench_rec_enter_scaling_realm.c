@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#include "test_database.h"
+#include "val_realm_framework.h"
+#include "val_realm_rsi.h"
+
+/* Set by the host in gprs[0] of the host call to end the exit loop */
+#define BENCH_STOP      1
+
+void bench_rec_enter_scaling_realm(void)
+{
+    __attribute__((aligned(PAGE_SIZE))) val_realm_rsi_host_call_t realm_host_params;
+
+    /* Exit to the host until it asks to stop, each exit is one sample */
+    do {
+        realm_host_params.gprs[0] = 0;
+        val_realm_rsi_host_params(&realm_host_params);
+    } while (realm_host_params.gprs[0] != BENCH_STOP);
+
+    val_realm_return_to_host();
+}
@@ -542,7 +542,7 @@ void cmd_data_create_host(void)
     for (i = 0; i < (sizeof(test_data) / sizeof(struct stimulus)); i++)
     {
         LOG(TEST, "\n\tCheck %d : ", i + 1, 0);
-        LOG(TEST, test_data[i].msg, 0, 0);
+        LOG_VAR(TEST, test_data[i].msg, 0, 0);
         LOG(TEST, "; intent id : 0x%x \n", test_data[i].label, 0);
 
         if (intent_to_seq(&test_data[i], &args)) {
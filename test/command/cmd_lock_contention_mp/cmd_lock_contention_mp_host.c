@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#include "test_database.h"
+#include "val_host_rmi.h"
+#include "val_timer.h"
+#include "pal.h"
+
+/* Lock and unlock pairs done by each CPU in a round */
+#define LOCK_ITERATIONS     0x1000
+#define MAX_CPUS            32
+
+#ifndef SECURE_TEST_ENABLE
+static val_host_future_ts cpu_done[MAX_CPUS];
+static barrier_t round_start;
+static s_lock_t contended_lock;
+static volatile uint64_t lock_counter;
+
+/* Returns the worst number of ticks spent waiting for the lock */
+static uint64_t lock_contention_run(void)
+{
+    uint64_t i, start, wait, worst = 0;
+
+    for (i = 0; i < LOCK_ITERATIONS; i++)
+    {
+        start = val_read_cntpct_el0();
+        val_spin_lock(&contended_lock);
+        wait = val_read_cntpct_el0() - start;
+        lock_counter++;
+        val_spin_unlock(&contended_lock);
+
+        if (wait > worst)
+            worst = wait;
+    }
+
+    return worst;
+}
+
+/* Posted to the parked secondaries, arg is the number of cpus in the round */
+static uint64_t lock_contention_worker(uint64_t arg)
+{
+    /* The round starts once all cpus taking part are ready */
+    val_barrier_wait(&round_start, (unsigned int)arg);
+
+    return lock_contention_run();
+}
+#endif
+
+void cmd_lock_contention_mp_host(void)
+{
+#ifdef SECURE_TEST_ENABLE
+    /* Secure infrasturcure does not support MP boot yet, hence skipping the test */
+    val_set_status(RESULT_SKIP(VAL_SKIP_CHECK));
+    goto exit;
+#else
+    uint64_t ret, start, ticks, wait, worst;
+    uint32_t i, n, cpus, cpu_count, primary_cpuid;
+
+    primary_cpuid = val_get_cpuid(val_read_mpidr() & PAL_MPIDR_AFFINITY_MASK);
+    cpu_count = val_get_cpu_count();
+    if (cpu_count > MAX_CPUS)
+        cpu_count = MAX_CPUS;
+
+    val_init_spinlock(&contended_lock);
+
+    /* One round per number of contending cpus, the primary always takes part */
+    for (n = 1; n <= cpu_count; n++)
+    {
+        lock_counter = 0;
+        val_init_barrier(&round_start);
+
+        for (i = 0, cpus = 1; i < cpu_count && cpus < n; i++)
+        {
+            if (i == primary_cpuid)
+                continue;
+
+            ret = val_host_park_cpu(i);
+            if (ret == VAL_SUCCESS)
+                ret = val_host_post_work(i, lock_contention_worker, n, &cpu_done[i]);
+
+            if (ret != VAL_SUCCESS)
+            {
+                LOG(ERROR, "\tUnable to run on cpu mpidr 0x%x, ret=%x\n", val_get_mpidr(i), ret);
+                val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+
+                /* Stand in for the cpus not started, releasing the started ones */
+                for (; cpus <= n; cpus++)
+                    val_barrier_arrive(&round_start, n);
+
+                while (i-- > 0)
+                {
+                    if (i != primary_cpuid)
+                        (void)val_host_wait_future(&cpu_done[i]);
+                }
+                goto exit;
+            }
+
+            cpus++;
+        }
+
+        val_barrier_wait(&round_start, n);
+        start = val_read_cntpct_el0();
+
+        worst = lock_contention_run();
+
+        for (i = 0, cpus = 1; i < cpu_count && cpus < n; i++)
+        {
+            if (i == primary_cpuid)
+                continue;
+
+            wait = val_host_wait_future(&cpu_done[i]);
+            if (wait > worst)
+                worst = wait;
+            cpus++;
+        }
+
+        ticks = val_read_cntpct_el0() - start;
+
+        if (lock_counter != (uint64_t)n * LOCK_ITERATIONS)
+        {
+            LOG(ERROR, "\tLost updates under the lock, count=%x expected=%x\n",
+                                lock_counter, (uint64_t)n * LOCK_ITERATIONS);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+            goto exit;
+        }
+
+        LOG(ALWAYS, "\tcpus %d : %d acquisitions/s\n", n,
+            (lock_counter * val_read_cntfrq_el0()) / (ticks ? ticks : 1));
+        LOG(ALWAYS, "\tcpus %d : worst wait %d ticks\n", n, worst);
+    }
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+#endif
+exit:
+    return;
+}
@@ -9,15 +9,16 @@
 #include "pal.h"
 
 #ifndef SECURE_TEST_ENABLE
-static event_t cpu_booted[32];
+static val_host_future_ts cpu_done;
 static val_host_realm_ts realm;
 
-static void secondary_cpu(void)
+/* Posted to a parked secondary cpu */
+static uint64_t secondary_cpu(uint64_t arg)
 {
 
     uint64_t mpidr = val_read_mpidr() & PAL_MPIDR_AFFINITY_MASK, ret;
 
-    LOG(ALWAYS, "\tSecondary cpu with mpidr 0x%x booted\n", mpidr, 0);
+    LOG(ALWAYS, "\tSecondary cpu with mpidr 0x%x running\n", mpidr, 0);
 
     /* Enter Realm-1 on secondary cpu */
     ret = val_host_rmi_rec_enter(realm.rec[1], realm.run[1]);
@@ -35,10 +36,8 @@ static void secondary_cpu(void)
         val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
     }
 
-    /* Tell the primary cpu that the calling cpu has completed the test */
-    val_send_event(&cpu_booted[val_get_cpuid(mpidr)]);
-
-    val_host_power_off_cpu();
+    (void)arg;
+    return VAL_SUCCESS;
 }
 #endif
 
@@ -52,11 +51,6 @@ void cmd_multithread_realm_mp_host(void)
     uint64_t ret, primary_mpidr, mpidr;
     uint32_t i;
 
-    if (val_get_primary_mpidr() != val_read_mpidr())
-        secondary_cpu();
-
-    /* Below code only be executed by primary cpu */
-
     val_memset(&realm, 0, sizeof(realm));
 
     val_host_realm_params(&realm);
@@ -98,13 +92,11 @@ void cmd_multithread_realm_mp_host(void)
         goto destroy_realm;
     }
 
-    /* Wake up the one of the secondary cpu to execute rec enter */
+    /* Run rec enter on one of the secondary cpus */
     primary_mpidr = val_read_mpidr() & PAL_MPIDR_AFFINITY_MASK;
 
     for (i = 0; i < val_get_cpu_count(); i++)
     {
-        val_init_event(&cpu_booted[i]);
-
         mpidr = val_get_mpidr(i);
 
         if (mpidr == primary_mpidr)
@@ -112,17 +104,20 @@ void cmd_multithread_realm_mp_host(void)
             continue;
         }
 
-        LOG(DBG, "\tPower up secondary cpu mpidr=%x\n", mpidr, 0);
-        ret = val_host_power_on_cpu(i);
+        LOG(DBG, "\tPark secondary cpu mpidr=%x\n", mpidr, 0);
+        ret = val_host_park_cpu(i);
+        if (ret == 0)
+            ret = val_host_post_work(i, secondary_cpu, 0, &cpu_done);
+
         if (ret != 0)
         {
-            LOG(ERROR, "\tval_power_on_cpu mpidr 0x%x returns %x\n", mpidr, ret);
+            LOG(ERROR, "\tval_host_park_cpu mpidr 0x%x returns %x\n", mpidr, ret);
             val_set_status(RESULT_FAIL(VAL_ERROR_POINT(7)));
             goto destroy_realm;
         }
 
-        val_wait_for_event(&cpu_booted[i]);
-        LOG(DBG, "\tPowered off secondary cpu mpidr=%x\n", mpidr, 0);
+        (void)val_host_wait_future(&cpu_done);
+        LOG(DBG, "\tSecondary cpu mpidr=%x done\n", mpidr, 0);
         break;
     }
 
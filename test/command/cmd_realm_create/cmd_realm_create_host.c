@@ -330,7 +330,7 @@ static uint64_t params_valid_prep_sequence(void)
 {
     /* Allocate a granule for RealmParams */
     val_host_realm_params_ts *params = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
-    val_memset(params, 0, PAGE_SIZE);
+    val_zero_granule(params);
 
     /* Allocate and delegate a granule for the L0 RTT */
     uint64_t rtt0 = g_delegated_prep_sequence();
@@ -668,7 +668,7 @@ void cmd_realm_create_host(void)
     for (i = 0; i < (sizeof(test_data) / sizeof(struct stimulus)); i++)
     {
         LOG(TEST, "\n\tCheck %d : ", i + 1, 0);
-        LOG(TEST, test_data[i].msg, 0, 0);
+        LOG_VAR(TEST, test_data[i].msg, 0, 0);
         LOG(TEST, "; intent id : 0x%x \n", test_data[i].label, 0);
 
         ret = intent_to_seq(&test_data[i], &args);
@@ -230,7 +230,7 @@ void cmd_realm_destroy_host(void)
     for (i = 0; i < (sizeof(test_data) / sizeof(struct stimulus)); i++)
     {
         LOG(TEST, "\n\tCheck %d : ", i + 1, 0);
-        LOG(TEST, test_data[i].msg, 0, 0);
+        LOG_VAR(TEST, test_data[i].msg, 0, 0);
         LOG(TEST, "; intent id : 0x%x \n", test_data[i].label, 0);
 
         if (intent_to_seq(&test_data[i], &args)) {
@@ -268,7 +268,7 @@ void cmd_realm_destroy_host(void)
         goto exit;
     }
 
-    val_memset(params, 0, PAGE_SIZE);
+    val_zero_granule(params);
     /* Populate params */
     params->rtt_base = realm[VALID_REALM].rtt_l0_addr;
     params->hash_algo = realm[VALID_REALM].hash_algo;
@@ -147,7 +147,7 @@ static uint64_t run_ptr_valid_prep_sequence(void)
     struct rec_entry *params = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
 
     /* Clear the structure entirely */
-    val_memset(params, 0x0, PAGE_SIZE);
+    val_zero_granule(params);
 
     return (uint64_t)params;
 }
@@ -196,7 +196,7 @@ static uint64_t emulated_mmio_prep_sequence(void)
     val_host_rec_enter_ts *run_ptr = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
 
     /* Clear the structure entirely */
-    val_memset(run_ptr, 0x0, PAGE_SIZE);
+    val_zero_granule(run_ptr);
 
     run_ptr->flags = 0x1;
 
@@ -208,7 +208,7 @@ static uint64_t gicv3_invalid_prep_sequence(void)
     val_host_rec_enter_ts *run_ptr = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
 
     /* Clear the structure entirely */
-    val_memset(run_ptr, 0x0, PAGE_SIZE);
+    val_zero_granule(run_ptr);
 
     run_ptr->gicv3_lrs[0] = 3ULL << 61;
 
@@ -606,7 +606,7 @@ void cmd_rec_enter_host(void)
     for (i = 0; i < (sizeof(test_data) / sizeof(struct stimulus)); i++)
     {
         LOG(TEST, "\n\tCheck %d : ", i + 1, 0);
-        LOG(TEST, test_data[i].msg, 0, 0);
+        LOG_VAR(TEST, test_data[i].msg, 0, 0);
         LOG(TEST, "; intent id : 0x%x \n", test_data[i].label, 0);
 
         if (intent_to_seq(&test_data[i], &args)) {
@@ -96,7 +96,7 @@ uint32_t val_host_realm_create_common(val_host_realm_ts *realm)
         goto undelegate_rtt;
     }
 
-    val_memset(params, 0, PAGE_SIZE);
+    val_zero_granule(params);
 
     /* Populate params */
     params->rtt_base = realm->rtt_l0_addr;
@@ -193,7 +193,7 @@ uint32_t val_host_rec_create_common(val_host_realm_ts *realm, val_host_rec_param
         LOG(ERROR, "\tFailed to allocate memory for rec_params\n", 0, 0);
         return VAL_ERROR;
     }
-    val_memset(rec_params, 0x0, PAGE_SIZE);
+    val_zero_granule(rec_params);
 
     /* Populate rec_params */
     rec_params->num_aux = aux_count;
@@ -218,7 +218,7 @@ uint32_t val_host_rec_create_common(val_host_realm_ts *realm, val_host_rec_param
             LOG(ERROR, "\tFailed to allocate memory for run[%d]\n", i, 0);
             goto free_rec_params;
         }
-        val_memset((void *)realm->run[i], 0x0, PAGE_SIZE);
+        val_zero_granule((void *)realm->run[i]);
 
         /* Allocate and delegate REC */
         realm->rec[i] = (uint64_t)val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
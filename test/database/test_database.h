@@ -16,6 +16,11 @@
 /* Test prototype */
 typedef void (*test_fptr_t)(void);
 
+/* Test flags */
+#define TEST_FLAG_NONE          0x0
+/* Test needs the whole platform and is never run in parallel with other tests */
+#define TEST_FLAG_EXCLUSIVE     0x1
+
 /* Structure to hold all test info */
 typedef struct {
     char                suite_name[PRINT_LIMIT];
@@ -23,24 +28,34 @@ typedef struct {
     test_fptr_t         host_fn; /* Host Test function */
     test_fptr_t         realm_fn; /* Realm Test function */
     test_fptr_t         secure_fn; /* Secure Test function */
+    uint32_t            flags; /* TEST_FLAG_* */
 } test_db_t;
 
+/* Per test execution time, filled by the host dispatcher */
+typedef struct {
+    uint64_t            ticks; /* System counter ticks */
+    uint64_t            cycles; /* PMU cycle counter, 0 without PMUv3 */
+} test_timing_t;
+
 #define DECLARE_TEST_FN(testname) \
     extern  void testname##_host(void);\
     extern  void testname##_realm(void);\
     extern  void testname##_secure(void);
 
 #define HOST_TEST_ONLY(suitename, testname) \
-    {"Suite="#suitename" : ", #testname, testname##_host, NULL, NULL}
+    {"Suite="#suitename" : ", #testname, testname##_host, NULL, NULL, TEST_FLAG_NONE}
+
+#define HOST_EXCLUSIVE_TEST_ONLY(suitename, testname) \
+    {"Suite="#suitename" : ", #testname, testname##_host, NULL, NULL, TEST_FLAG_EXCLUSIVE}
 
 #define REALM_TEST_ONLY(suitename, testname) \
-    {" "#suitename, #testname, NULL, testname##_realm, NULL}
+    {" "#suitename, #testname, NULL, testname##_realm, NULL, TEST_FLAG_NONE}
 
 #define SECURE_TEST_ONLY(suitename, testname) \
-    {" "#suitename, #testname, NULL, NULL, testname##_secure}
+    {" "#suitename, #testname, NULL, NULL, testname##_secure, TEST_FLAG_NONE}
 
 #define DUMMY_TEST(suitename, testname) \
-    {" ", " ", NULL, NULL, NULL}
+    {" ", " ", NULL, NULL, NULL, TEST_FLAG_NONE}
 
 #define TEST_FUNC_DECLARATION
 #include "test_list.h"
@@ -6,19 +6,27 @@
  */
 
 #include "test_database.h"
+#include "val_host_realm.h"
 
 #define TEST_FUNC_DATABASE
-#define HOST_TEST(x, y)              HOST_TEST_ONLY(x, y)
-#define HOST_REALM_TEST(x, y)        HOST_TEST_ONLY(x, y)
-#define HOST_SECURE_TEST(x, y)       HOST_TEST_ONLY(x, y)
-#define HOST_REALM_SECURE_TEST(x, y) HOST_TEST_ONLY(x, y)
+#define HOST_TEST(x, y)                 HOST_TEST_ONLY(x, y)
+#define HOST_REALM_TEST(x, y)           HOST_TEST_ONLY(x, y)
+#define HOST_SECURE_TEST(x, y)          HOST_EXCLUSIVE_TEST_ONLY(x, y)
+#define HOST_REALM_SECURE_TEST(x, y)    HOST_EXCLUSIVE_TEST_ONLY(x, y)
+#define HOST_EXCLUSIVE_TEST(x, y)       HOST_EXCLUSIVE_TEST_ONLY(x, y)
+#define HOST_REALM_EXCLUSIVE_TEST(x, y) HOST_EXCLUSIVE_TEST_ONLY(x, y)
 
 const test_db_t test_list[] = {
-    {"", "", NULL, NULL, NULL},
+    {"", "", NULL, NULL, NULL, TEST_FLAG_NONE},
 
 #include "test_list.h"
-    {"", "", NULL, NULL, NULL},
+    {"", "", NULL, NULL, NULL, TEST_FLAG_NONE},
 
 };
 
 const uint32_t total_tests = sizeof(test_list)/sizeof(test_list[0]);
+
+test_timing_t test_timing[sizeof(test_list)/sizeof(test_list[0])];
+
+/* Per test heap and granule usage, filled by the host dispatcher */
+val_host_mem_stats_ts test_mem_stats[sizeof(test_list)/sizeof(test_list[0])];
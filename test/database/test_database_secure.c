@@ -8,10 +8,12 @@
 #include "test_database.h"
 
 #define TEST_FUNC_DATABASE
-#define HOST_TEST(x, y)              DUMMY_TEST(x, y)
-#define HOST_REALM_TEST(x, y)        DUMMY_TEST(x, y)
-#define HOST_SECURE_TEST(x, y)       SECURE_TEST_ONLY(x, y)
-#define HOST_REALM_SECURE_TEST(x, y) SECURE_TEST_ONLY(x, y)
+#define HOST_TEST(x, y)                 DUMMY_TEST(x, y)
+#define HOST_REALM_TEST(x, y)           DUMMY_TEST(x, y)
+#define HOST_SECURE_TEST(x, y)          SECURE_TEST_ONLY(x, y)
+#define HOST_REALM_SECURE_TEST(x, y)    SECURE_TEST_ONLY(x, y)
+#define HOST_EXCLUSIVE_TEST(x, y)       DUMMY_TEST(x, y)
+#define HOST_REALM_EXCLUSIVE_TEST(x, y) DUMMY_TEST(x, y)
 
 /* Secure tests are combined into single image only */
 #ifndef TEST_COMBINE
@@ -19,10 +21,10 @@
 #endif
 
 const test_db_t test_list[] = {
-    {"", "", NULL, NULL, NULL},
+    {"", "", NULL, NULL, NULL, TEST_FLAG_NONE},
 
 #include "test_list.h"
-    {"", "", NULL, NULL, NULL},
+    {"", "", NULL, NULL, NULL, TEST_FLAG_NONE},
 
 };
 
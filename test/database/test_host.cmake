@@ -49,6 +49,8 @@ file(GLOB TEST_SRC
     "${ROOT_DIR}/test/*/common/*_host.c"
     "${ROOT_DIR}/test/common/*_host.c"
 )
+# Benchmarks are not a compliance check, built only with SUITE=benchmark
+list(FILTER TEST_SRC EXCLUDE REGEX "/test/benchmark/")
 else()
 file(GLOB TEST_SRC
     "${ROOT_DIR}/test/${SUITE}/*/*_host.c"
@@ -84,6 +86,8 @@ set(TEST_SOURCE_DIR ${ROOT_DIR}/test)
 if(SUITE STREQUAL "all")
     # Get all the test pool components
     _get_sub_dir_list(SUITE_LIST ${TEST_SOURCE_DIR})
+    # Benchmarks are not a compliance check, built only with SUITE=benchmark
+    list(REMOVE_ITEM SUITE_LIST benchmark)
 else()
     set(SUITE_LIST ${SUITE})
 endif()
@@ -71,6 +71,7 @@ DECLARE_TEST_FN(cmd_mec_set_private);
 /*val sanity testcase starts here*/
 DECLARE_TEST_FN(cmd_multithread_realm_up);
 DECLARE_TEST_FN(cmd_multithread_realm_mp);
+DECLARE_TEST_FN(cmd_lock_contention_mp);
 DECLARE_TEST_FN(cmd_secure_test);
 /*val sanity testcase ends here*/
 
@@ -113,6 +114,7 @@ DECLARE_TEST_FN(mm_feat_s2fwb_check_2);
 DECLARE_TEST_FN(mm_feat_s2fwb_check_3);
 DECLARE_TEST_FN(mm_ha_hd_access);
 DECLARE_TEST_FN(mm_realm_access_outside_ipa);
+DECLARE_TEST_FN(mm_block_map_perf);
 /*memory management testcase declaration ends here*/
 
 /*Exception model declaration starts here*/
@@ -186,6 +188,11 @@ DECLARE_TEST_FN(mec_private_shared);
 DECLARE_TEST_FN(lfa_test);
 /* LFA testcase declaration ends here */
 
+/* Benchmark testcase declaration starts here */
+DECLARE_TEST_FN(bench_rec_enter_scaling);
+DECLARE_TEST_FN(bench_granule_delegate);
+/* Benchmark testcase declaration ends here */
+
 
 #else /* TEST_FUNC_DATABASE */
 /* Add test funcs to the respective host/realm/secure test_list array */
@@ -234,7 +241,10 @@ DECLARE_TEST_FN(lfa_test);
         HOST_REALM_TEST(command, cmd_multithread_realm_up),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_cmd_multithread_realm_mp))
-        HOST_REALM_TEST(command, cmd_multithread_realm_mp),
+        HOST_REALM_EXCLUSIVE_TEST(command, cmd_multithread_realm_mp),
+        #endif
+        #if (defined(TEST_COMBINE) || defined(d_cmd_lock_contention_mp))
+        HOST_EXCLUSIVE_TEST(command, cmd_lock_contention_mp),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_cmd_rsi_features))
         HOST_REALM_TEST(command, cmd_rsi_features),
@@ -294,7 +304,7 @@ DECLARE_TEST_FN(lfa_test);
         HOST_REALM_TEST(command, cmd_system_off),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_cmd_system_reset))
-        HOST_REALM_TEST(command, cmd_system_reset),
+        HOST_REALM_EXCLUSIVE_TEST(command, cmd_system_reset),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_cmd_measurement_read))
         HOST_REALM_TEST(command, cmd_measurement_read),
@@ -381,7 +391,7 @@ DECLARE_TEST_FN(lfa_test);
             HOST_REALM_TEST(exception, exception_rec_exit_wfi),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_exception_rec_exit_irq))
-            HOST_REALM_TEST(exception, exception_rec_exit_irq),
+            HOST_REALM_EXCLUSIVE_TEST(exception, exception_rec_exit_irq),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_exception_rec_exit_hostcall))
             HOST_REALM_TEST(exception, exception_rec_exit_hostcall),
@@ -421,34 +431,34 @@ DECLARE_TEST_FN(lfa_test);
 
     #if (defined(d_all) || defined(d_gic))
         #if (defined(TEST_COMBINE) || defined(d_gic_timer_nsel2_trig))
-        HOST_REALM_TEST(gic, gic_timer_nsel2_trig),
+        HOST_REALM_EXCLUSIVE_TEST(gic, gic_timer_nsel2_trig),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_gic_hcr_invalid))
-        HOST_REALM_TEST(gic, gic_hcr_invalid),
+        HOST_REALM_EXCLUSIVE_TEST(gic, gic_hcr_invalid),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_gic_ctrl_list_invalid))
-        HOST_REALM_TEST(gic, gic_ctrl_list_invalid),
+        HOST_REALM_EXCLUSIVE_TEST(gic, gic_ctrl_list_invalid),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_gic_ctrl_list))
-        HOST_REALM_TEST(gic, gic_ctrl_list),
+        HOST_REALM_EXCLUSIVE_TEST(gic, gic_ctrl_list),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_gic_obsv_vmcr))
-        HOST_REALM_TEST(gic, gic_obsv_vmcr),
+        HOST_REALM_EXCLUSIVE_TEST(gic, gic_obsv_vmcr),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_gic_timer_val_read))
-        HOST_REALM_TEST(gic, gic_timer_val_read),
+        HOST_REALM_EXCLUSIVE_TEST(gic, gic_timer_val_read),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_gic_timer_rel1_trig))
-        HOST_REALM_TEST(gic, gic_timer_rel1_trig),
+        HOST_REALM_EXCLUSIVE_TEST(gic, gic_timer_rel1_trig),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_gic_ctrl_hcr))
-        HOST_REALM_TEST(gic, gic_ctrl_hcr),
+        HOST_REALM_EXCLUSIVE_TEST(gic, gic_ctrl_hcr),
         #endif
     #endif /* #if (defined(d_all) || defined(d_gic)) */
 
     #if (defined(d_all) || defined(d_pmu_debug))
         #if (defined(TEST_COMBINE) || defined(d_pmu_overflow))
-        HOST_REALM_TEST(pmu_debug, pmu_overflow),
+        HOST_REALM_EXCLUSIVE_TEST(pmu_debug, pmu_overflow),
         #endif
     #endif /* #if (defined(d_all) || defined(d_pmu_debug)) */
 
@@ -487,7 +497,7 @@ DECLARE_TEST_FN(lfa_test);
         HOST_REALM_TEST(attestation_measurement, attestation_rem_extend_check_realm_token),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_attestation_rec_exit_irq))
-        HOST_REALM_TEST(attestation_measurement, attestation_rec_exit_irq),
+        HOST_REALM_EXCLUSIVE_TEST(attestation_measurement, attestation_rec_exit_irq),
         #endif
     #endif /* #if (defined(d_all) || defined(d_attestation_measurement)) */
 
@@ -514,7 +524,7 @@ DECLARE_TEST_FN(lfa_test);
         HOST_REALM_TEST(memory_management, mm_hipas_unassigned_ns_da_ia),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_mm_gpf_exception))
-        HOST_TEST(memory_management, mm_gpf_exception),
+        HOST_EXCLUSIVE_TEST(memory_management, mm_gpf_exception),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_mm_unprotected_ipa_boundary))
         HOST_REALM_TEST(memory_management, mm_unprotected_ipa_boundary),
@@ -565,6 +575,15 @@ DECLARE_TEST_FN(lfa_test);
     #endif /* #if (defined(d_all) || defined(d_memory_management)) */
 #endif /* #if defined(RMM_V_1_0) */
 
+/* Tests common to RMM v1.0 and v1.1 */
+#if defined(RMM_V_1_0) || defined(RMM_V_1_1)
+    #if (defined(d_all) || defined(d_memory_management))
+        #if (defined(TEST_COMBINE) || defined(d_mm_block_map_perf))
+        HOST_REALM_EXCLUSIVE_TEST(memory_management, mm_block_map_perf),
+        #endif
+    #endif /* #if (defined(d_all) || defined(d_memory_management)) */
+#endif /* #if defined(RMM_V_1_0) || defined(RMM_V_1_1) */
+
 #if defined(RMM_V_1_1)
     #if (defined(d_all) || defined(d_planes))
         #if (defined(TEST_COMBINE) || defined(d_planes_plane_exit_smc_hvc))
@@ -601,7 +620,7 @@ DECLARE_TEST_FN(lfa_test);
         HOST_REALM_TEST(planes, planes_rec_exit_da_hipas_unassigned_ns),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_planes_rec_exit_irq))
-        HOST_REALM_TEST(planes, planes_rec_exit_irq),
+        HOST_REALM_EXCLUSIVE_TEST(planes, planes_rec_exit_irq),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_planes_rec_exit_host_call))
         HOST_REALM_TEST(planes, planes_rec_exit_host_call),
@@ -634,7 +653,7 @@ DECLARE_TEST_FN(lfa_test);
         HOST_REALM_TEST(planes, planes_rec_entry_maint_int),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_planes_el1_timer_trig))
-        HOST_REALM_TEST(planes, planes_el1_timer_trig),
+        HOST_REALM_EXCLUSIVE_TEST(planes, planes_el1_timer_trig),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_planes_timer_state_rec_exit))
         HOST_REALM_TEST(planes, planes_timer_state_rec_exit),
@@ -645,22 +664,22 @@ DECLARE_TEST_FN(lfa_test);
 #if defined(RMM_V_1_1)
     #if (defined(d_all) || defined(d_mec))
         #if (defined(TEST_COMBINE) || defined(d_mec_feat_support))
-        HOST_TEST(mec, mec_feat_support),
+        HOST_EXCLUSIVE_TEST(mec, mec_feat_support),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_mec_id_shared))
-        HOST_REALM_TEST(mec, mec_id_shared),
+        HOST_REALM_EXCLUSIVE_TEST(mec, mec_id_shared),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_mec_id_private))
-        HOST_REALM_TEST(mec, mec_id_private),
+        HOST_REALM_EXCLUSIVE_TEST(mec, mec_id_private),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_mec_private_shared))
-        HOST_REALM_TEST(mec, mec_private_shared),
+        HOST_REALM_EXCLUSIVE_TEST(mec, mec_private_shared),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_cmd_mec_set_shared))
-        HOST_TEST(mec, cmd_mec_set_shared),
+        HOST_EXCLUSIVE_TEST(mec, cmd_mec_set_shared),
         #endif
         #if (defined(TEST_COMBINE) || defined(d_cmd_mec_set_private))
-        HOST_TEST(mec, cmd_mec_set_private),
+        HOST_EXCLUSIVE_TEST(mec, cmd_mec_set_private),
         #endif
     #endif /* #if (defined(d_all) || defined(d_mec)) */
 #endif /* #if defined(RMM_V_1_1) */
@@ -668,9 +687,19 @@ DECLARE_TEST_FN(lfa_test);
 #if defined(RMM_V_1_1)
     #if (defined(d_all) || defined(d_lfa))
         #if (defined(TEST_COMBINE) || defined(d_lfa_test))
-        HOST_TEST(lfa, lfa_test),
+        HOST_EXCLUSIVE_TEST(lfa, lfa_test),
         #endif
     #endif /* #if (defined(d_all) || defined(d_lfa)) */
 #endif /* #if defined(RMM_V_1_1) */
 
+/* Performance figures, not a compliance check, so only built for SUITE=benchmark */
+#if defined(d_benchmark)
+    #if (defined(TEST_COMBINE) || defined(d_bench_rec_enter_scaling))
+    HOST_REALM_EXCLUSIVE_TEST(benchmark, bench_rec_enter_scaling),
+    #endif
+    #if (defined(TEST_COMBINE) || defined(d_bench_granule_delegate))
+    HOST_EXCLUSIVE_TEST(benchmark, bench_granule_delegate),
+    #endif
+#endif /* #if defined(d_benchmark) */
+
 #endif /* TEST_FUNC_DATABASE */
@@ -53,6 +53,8 @@ file(GLOB TEST_SRC
     "${RMM_ACS_TARGET_QCBOR}/src/UsefulBuf.c"
     "${RMM_ACS_TARGET_QCBOR}/src/ieee754.c"
 )
+# Benchmarks are not a compliance check, built only with SUITE=benchmark
+list(FILTER TEST_SRC EXCLUDE REGEX "/test/benchmark/")
 else()
 file(GLOB TEST_SRC
     "${ROOT_DIR}/test/${SUITE}/*/*_realm.c"
@@ -91,6 +93,8 @@ set(TEST_SOURCE_DIR ${ROOT_DIR}/test)
 if(SUITE STREQUAL "all")
     # Get all the test pool components
     _get_sub_dir_list(SUITE_LIST ${TEST_SOURCE_DIR})
+    # Benchmarks are not a compliance check, built only with SUITE=benchmark
+    list(REMOVE_ITEM SUITE_LIST benchmark)
 else()
     set(SUITE_LIST ${SUITE})
 endif()
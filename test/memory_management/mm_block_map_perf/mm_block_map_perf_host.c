@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#include "test_database.h"
+#include "val_host_rmi.h"
+#include "val_host_realm.h"
+
+#define BENCH_SIZE          VAL_RTT_L2_BLOCK_SIZE
+#define IPA_PAGE_MAPPED     0x800000
+#define IPA_BLOCK_MAPPED    0xA00000
+
+void mm_block_map_perf_host(void)
+{
+    val_host_realm_ts realm;
+    val_host_rec_enter_ts *rec_enter = NULL;
+    val_host_rtt_entry_ts rtte;
+    val_data_create_ts data_create;
+    uint64_t ret, src, target;
+
+    val_memset(&realm, 0, sizeof(realm));
+
+    val_host_realm_params(&realm);
+
+    /* Populate realm with one REC */
+    if (val_host_realm_setup(&realm, false))
+    {
+        LOG(ERROR, "\tRealm setup failed\n", 0, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+        goto destroy_realm;
+    }
+
+    src = (uint64_t)val_host_mem_alloc(PAGE_SIZE, BENCH_SIZE);
+    target = (uint64_t)val_host_mem_alloc(VAL_RTT_L2_BLOCK_SIZE, 2 * BENCH_SIZE);
+    if (!src || !target)
+    {
+        LOG(ERROR, "\tval_host_mem_alloc failed\n", 0, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(2)));
+        goto destroy_realm;
+    }
+
+    /* Same contents behind a 4K mapped and a 2MB block mapped range */
+    data_create.src_pa = src;
+    data_create.target_pa = target;
+    data_create.ipa = IPA_PAGE_MAPPED;
+    data_create.size = BENCH_SIZE;
+    data_create.rtt_alignment = PAGE_SIZE;
+    if (val_host_map_protected_data_to_realm(&realm, &data_create))
+    {
+        LOG(ERROR, "\tval_host_map_protected_data_to_realm failed\n", 0, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(3)));
+        goto destroy_realm;
+    }
+
+    data_create.target_pa = target + BENCH_SIZE;
+    data_create.ipa = IPA_BLOCK_MAPPED;
+    if (val_host_map_protected_block_to_realm(&realm, &data_create))
+    {
+        LOG(ERROR, "\tval_host_map_protected_block_to_realm failed\n", 0, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(4)));
+        goto destroy_realm;
+    }
+
+    ret = val_host_rmi_rtt_read_entry(realm.rd, IPA_BLOCK_MAPPED, VAL_RTT_MAX_LEVEL, &rtte);
+    if (ret)
+    {
+        LOG(ERROR, "\trtt_read_entry failed ret = %x\n", ret, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(5)));
+        goto destroy_realm;
+    }
+
+    if (rtte.walk_level != (VAL_RTT_MAX_LEVEL - 1) || rtte.state != RMI_ASSIGNED)
+    {
+        LOG(ERROR, "\tBlock mapping missing, level=%d, state=%d\n", rtte.walk_level, rtte.state);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(6)));
+        goto destroy_realm;
+    }
+
+    /* Activate realm */
+    if (val_host_realm_activate(&realm))
+    {
+        LOG(ERROR, "\tRealm activate failed\n", 0, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(7)));
+        goto destroy_realm;
+    }
+
+    /* Enter REC[0], the realm asks for the benchmark ranges */
+    ret = val_host_rmi_rec_enter(realm.rec[0], realm.run[0]);
+    if (ret)
+    {
+        LOG(ERROR, "\tRec enter failed, ret=%x\n", ret, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(8)));
+        goto destroy_realm;
+    } else if (val_host_check_realm_exit_host_call((val_host_rec_run_ts *)realm.run[0]))
+    {
+        LOG(ERROR, "\tHost call params mismatch\n", 0, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(9)));
+        goto destroy_realm;
+    }
+
+    rec_enter = &(((val_host_rec_run_ts *)realm.run[0])->enter);
+    rec_enter->gprs[1] = IPA_PAGE_MAPPED;
+    rec_enter->gprs[2] = IPA_BLOCK_MAPPED;
+    rec_enter->gprs[3] = BENCH_SIZE;
+
+    ret = val_host_rmi_rec_enter(realm.rec[0], realm.run[0]);
+    if (ret)
+    {
+        LOG(ERROR, "\tRec enter failed, ret=%x\n", ret, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(10)));
+        goto destroy_realm;
+    } else if (val_host_check_realm_exit_host_call((val_host_rec_run_ts *)realm.run[0]))
+    {
+        LOG(ERROR, "\tHost call params mismatch\n", 0, 0);
+        val_set_status(RESULT_FAIL(VAL_ERROR_POINT(11)));
+        goto destroy_realm;
+    }
+
+    val_set_status(RESULT_PASS(VAL_SUCCESS));
+
+    /* Free test resources */
+destroy_realm:
+    return;
+}
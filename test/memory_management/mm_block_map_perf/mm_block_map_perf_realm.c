@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+#include "test_database.h"
+#include "val_realm_framework.h"
+#include "val_realm_rsi.h"
+#include "val_realm_memory.h"
+#include "val_timer.h"
+
+/* Passes over the range for streaming, loads for random access */
+#define STREAM_PASSES       8
+#define RANDOM_ACCESSES     0x40000
+#define CACHE_LINE_SIZE     64
+
+/* Keeps the benchmark loads from being optimised away */
+static volatile uint64_t bench_sink;
+
+static uint64_t mm_block_map_perf_rate(uint64_t count, uint64_t ticks)
+{
+    /* Per second, a zero tick run is reported as one tick */
+    return (count * val_read_cntfrq_el0()) / (ticks ? ticks : 1);
+}
+
+static uint64_t mm_block_map_perf_stream(uint64_t base, uint64_t size)
+{
+    uint64_t *p = (uint64_t *)base;
+    uint64_t i, pass, sum = 0, start;
+
+    start = val_read_cntpct_el0();
+    for (pass = 0; pass < STREAM_PASSES; pass++)
+    {
+        for (i = 0; i < size / sizeof(uint64_t); i++)
+            sum += p[i];
+    }
+    bench_sink = sum;
+
+    return mm_block_map_perf_rate(size * STREAM_PASSES, val_read_cntpct_el0() - start);
+}
+
+static uint64_t mm_block_map_perf_random(uint64_t base, uint64_t size)
+{
+    uint64_t lines = size / CACHE_LINE_SIZE;
+    uint64_t i, sum = 0, start, seed = 0x2545F4914F6CDD1DULL;
+
+    start = val_read_cntpct_el0();
+    for (i = 0; i < RANDOM_ACCESSES; i++)
+    {
+        /* LCG, one line per load so every page of the range gets hit */
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        sum += *(volatile uint64_t *)(base + ((seed >> 33) % lines) * CACHE_LINE_SIZE);
+    }
+    bench_sink = sum;
+
+    return mm_block_map_perf_rate(RANDOM_ACCESSES, val_read_cntpct_el0() - start);
+}
+
+void mm_block_map_perf_realm(void)
+{
+    val_realm_rsi_host_call_t *gv_realm_host_call;
+    val_memory_region_descriptor_ts mem_desc;
+    uint64_t ipa[2], size, i;
+
+    /* Below code is executed for REC[0] only */
+    LOG(DBG, "\tIn realm_create_realm REC[0], mpdir=%x\n", val_read_mpidr(), 0);
+    gv_realm_host_call = val_realm_rsi_host_call_ripas(VAL_SWITCH_TO_HOST);
+    ipa[0] = gv_realm_host_call->gprs[1];
+    ipa[1] = gv_realm_host_call->gprs[2];
+    size = gv_realm_host_call->gprs[3];
+
+    for (i = 0; i < 2; i++)
+    {
+        mem_desc.virtual_address = ipa[i];
+        mem_desc.physical_address = ipa[i];
+        mem_desc.length = size;
+        mem_desc.attributes = MT_RW_DATA | MT_REALM;
+        if (val_realm_pgt_create(&mem_desc))
+        {
+            LOG(ERROR, "\tVA to PA mapping failed\n", 0, 0);
+            val_set_status(RESULT_FAIL(VAL_ERROR_POINT(1)));
+            goto exit;
+        }
+
+        /* Untimed pass so both ranges start with warm caches and TLBs */
+        mm_block_map_perf_stream(ipa[i], size);
+    }
+
+    LOG(ALWAYS, "\t4K mapped    : stream %d bytes/s, random %d loads/s\n",
+        mm_block_map_perf_stream(ipa[0], size), mm_block_map_perf_random(ipa[0], size));
+    LOG(ALWAYS, "\t2MB mapped   : stream %d bytes/s, random %d loads/s\n",
+        mm_block_map_perf_stream(ipa[1], size), mm_block_map_perf_random(ipa[1], size));
+
+exit:
+    val_realm_return_to_host();
+}
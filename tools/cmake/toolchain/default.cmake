@@ -12,4 +12,11 @@ set(TARGET_DFLT tgt_tfa_fvp)
 set(SUITE_DFLT all)
 set(ENABLE_PIE_DFLT ON)
 set(TEST_COMBINE_DFLT OFF)
+set(PARALLEL_DISPATCH_DFLT OFF)
+set(RMI_PROFILE_DFLT OFF)
+set(BINARY_LOG_DFLT OFF)
+set(SHADOW_RTT_CHECK_DFLT OFF)
+set(BOOT_BENCHMARK_DFLT OFF)
+set(SPIN_LOCK_DFLT TAS)
+set(HEAP_WARN_PERCENT_DFLT 25)
 set(CMAKE_BUILD_TYPE_DFLT Release)
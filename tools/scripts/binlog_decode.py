@@ -0,0 +1,181 @@
+#-------------------------------------------------------------------------------
+# Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+#
+# SPDX-License-Identifier: BSD-3-Clause
+#
+#-------------------------------------------------------------------------------
+
+#------------------------------------------------------------------------------
+# Decodes the binary log of an ACS built with -DBINARY_LOG=ON.
+#
+# The host prints its record buffer as lines of the form
+#   BINLOG START <count> <dropped>
+#   BINLOG FREQ <cntfrq>
+#   BINLOG <id|image<<32|cpu<<40> <timestamp> <data1> <data2>
+#   BINLOG END
+# with all values in hex. The id is the offset of the format string from
+# __BINLOG_FMT_START__ in the image that logged it. The format strings are
+# only kept in the .binlog_fmt section of the ELF, not in the loaded binary,
+# so the host and realm ELF files of the same build are needed to render the
+# messages.
+#
+# usage: binlog_decode.py --host acs_host.elf [--realm acs_realm.elf] uart.log
+#------------------------------------------------------------------------------
+
+import argparse
+import re
+import struct
+import sys
+
+IMAGE_HOST = 1
+IMAGE_REALM = 2
+IMAGE_SECURE = 3
+IMAGE_NAMES = {IMAGE_HOST: "HOST", IMAGE_REALM: "REALM", IMAGE_SECURE: "SECURE"}
+
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+SHF_ALLOC = 0x2
+
+BINLOG_RE = re.compile(r"BINLOG ([0-9A-F]+) ([0-9A-F]+) ([0-9A-F]+) ([0-9A-F]+)")
+FREQ_RE = re.compile(r"BINLOG FREQ ([0-9A-F]+)")
+START_RE = re.compile(r"BINLOG START ([0-9A-F]+) ([0-9A-F]+)")
+
+
+class Elf(object):
+	"""Minimal little endian ELF64 reader, sections and symbols only."""
+
+	def __init__(self, path):
+		with open(path, "rb") as f:
+			self.data = f.read()
+
+		if self.data[:4] != b"\x7fELF" or self.data[4] != 2 or self.data[5] != 1:
+			raise ValueError("%s: not a little endian ELF64 file" % path)
+
+		(shoff,) = struct.unpack_from("<Q", self.data, 0x28)
+		shentsize, shnum, shstrndx = struct.unpack_from("<HHH", self.data, 0x3A)
+
+		self.sections = []
+		for i in range(shnum):
+			name, stype, flags, addr, offset, size, link = struct.unpack_from(
+				"<IIQQQQI", self.data, shoff + i * shentsize)
+			self.sections.append({"name": name, "type": stype, "flags": flags,
+					      "addr": addr, "offset": offset, "size": size,
+					      "link": link})
+
+		self.fmt_start = self.symbol("__BINLOG_FMT_START__")
+
+	def _str(self, offset):
+		end = self.data.index(b"\0", offset)
+		return self.data[offset:end].decode("ascii", "replace")
+
+	def symbol(self, wanted):
+		for sec in self.sections:
+			if sec["type"] != SHT_SYMTAB:
+				continue
+			strtab = self.sections[sec["link"]]
+			for off in range(sec["offset"], sec["offset"] + sec["size"], 24):
+				name, _, _, _, value, _ = struct.unpack_from("<IBBHQQ", self.data, off)
+				if self._str(strtab["offset"] + name) == wanted:
+					return value
+		raise ValueError("symbol %s not found, is the ELF stripped?" % wanted)
+
+	def string_at(self, addr):
+		for sec in self.sections:
+			# .binlog_fmt is not allocated but keeps its link address,
+			# other unallocated sections (debug, symbols) sit at 0
+			if sec["type"] == SHT_NOBITS:
+				continue
+			if not (sec["flags"] & SHF_ALLOC) and not sec["addr"]:
+				continue
+			if sec["addr"] <= addr < sec["addr"] + sec["size"]:
+				return self._str(sec["offset"] + addr - sec["addr"])
+		return None
+
+	def format_string(self, fmt_id):
+		return self.string_at(self.fmt_start + fmt_id)
+
+
+def render(fmt, data1, data2):
+	"""Formats a message exactly like pal_printf: %d, %x, optional l/L,
+	any other conversion prints 0 and does not consume a value."""
+	out = []
+	data = data1
+	i = 0
+	while i < len(fmt):
+		c = fmt[i]
+		if c != "%":
+			out.append(c)
+			i += 1
+			continue
+
+		i += 1
+		if i < len(fmt) and fmt[i] in "lL":
+			i += 1
+		conv = fmt[i] if i < len(fmt) else ""
+		if conv == "d":
+			out.append("%d" % data)
+			data = data2
+		elif conv in "xX" and conv:
+			out.append("%X" % data)
+			data = data2
+		else:
+			out.append("0")
+		i += 1
+	return "".join(out)
+
+
+def main():
+	parser = argparse.ArgumentParser(description="Decode ACS BINLOG records")
+	parser.add_argument("--host", required=True, help="acs_host.elf of the build")
+	parser.add_argument("--realm", help="acs_realm.elf of the build")
+	parser.add_argument("--raw", action="store_true",
+			    help="print timestamps in ticks instead of microseconds")
+	parser.add_argument("log", nargs="?", help="UART log, stdin when omitted")
+	args = parser.parse_args()
+
+	elfs = {IMAGE_HOST: Elf(args.host)}
+	if args.realm:
+		elfs[IMAGE_REALM] = Elf(args.realm)
+
+	stream = open(args.log, "r", errors="replace") if args.log else sys.stdin
+	freq = 0
+	records = []
+	for line in stream:
+		m = START_RE.search(line)
+		if m:
+			dropped = int(m.group(2), 16)
+			if dropped:
+				print("# %d records were overwritten before this dump" % dropped)
+			continue
+		m = FREQ_RE.search(line)
+		if m:
+			freq = int(m.group(1), 16)
+			continue
+		m = BINLOG_RE.search(line)
+		if m:
+			word, ts, data1, data2 = [int(g, 16) for g in m.groups()]
+			records.append((ts, (word >> 32) & 0xFF, (word >> 40) & 0xFF,
+					word & 0xFFFFFFFF, data1, data2))
+
+	# Realm records reach the host buffer on REC exit, order by time
+	records.sort(key=lambda r: r[0])
+	for ts, image, cpu, fmt_id, data1, data2 in records:
+		elf = elfs.get(image)
+		fmt = elf.format_string(fmt_id) if elf else None
+		if fmt is None:
+			msg = "<unknown id 0x%x data 0x%x 0x%x>\n" % (fmt_id, data1, data2)
+		else:
+			msg = render(fmt, data1, data2)
+
+		if freq and not args.raw:
+			stamp = "%14.3fus" % (ts * 1000000.0 / freq)
+		else:
+			stamp = "%16d" % ts
+		sys.stdout.write("[%s %-6s cpu%-2d] %s" % (stamp,
+				 IMAGE_NAMES.get(image, "?"), cpu, msg))
+		if not msg.endswith("\n"):
+			sys.stdout.write("\n")
+
+
+if __name__ == "__main__":
+	main()
@@ -66,7 +66,10 @@ extern uint64_t security_state;
  * 0x68 - 0x6F   REALM_PRINTF_DATA1
  * 0x70 - 0x77   REALM_PRINTF_DATA2
  * 0x78 - 0x9F   TEST_NAME_STRING - 40 Chars
- * 0xA0 - 0xFFF  VAL_RESERVED
+ * 0xA0 - 0xFF   VAL_RESERVED
+ * 0x100 - 0x10F REALM_LOG_RING header
+ * 0x110 - 0x7FF VAL_RESERVED
+ * 0x800 - 0xFFF REALM_LOG_RING data
  * 0x1000 - SHARED_END - Test usecase
  * */
 
@@ -77,6 +80,7 @@ typedef enum {
     VAL_PRINTF_DATA1      = 13,
     VAL_PRINTF_DATA2      = 14,
     VAL_CURR_TEST_NAME    = 15,
+    VAL_LOG_RING          = 32,
     VAL_TEST_USE1         = 512,
     VAL_TEST_USE2         = 520,
     VAL_TEST_USE3         = 528,
@@ -98,6 +102,31 @@ typedef enum {
 #define TEST_USE_OFFSET4 OFFSET(VAL_TEST_USE4)
 #define TEST_USE_OFFSET5 OFFSET(VAL_TEST_USE5)
 #define PRINT_OFFSET OFFSET(VAL_PRINT_OFFSET)
+#define LOG_RING_OFFSET OFFSET(VAL_LOG_RING)
+
+/* Realm log ring, single producer (realm) single consumer (host).
+ * Realm appends records while it runs, host drains them on REC exit.
+ * Record layout: val_log_ring_rec_ts followed by the NUL terminated message.
+ * With BINARY_LOG a record of len 0 is a binary log record with no message.
+ * */
+#define LOG_RING_DATA_OFFSET     0x800
+#define LOG_RING_DATA_SIZE       0x800
+#define LOG_RING_MSG_MAX         256
+
+typedef struct {
+    volatile uint32_t head;   /* Next free byte, written by realm only */
+    volatile uint32_t tail;   /* Next record to print, written by host only */
+    s_lock_t lock;            /* Serialises the RECs, taken with val_shared_spin_lock */
+} val_log_ring_ts;
+
+typedef struct {
+    uint64_t data1;
+    uint64_t data2;
+    uint16_t len;             /* Message length including NUL, 0 for a binary record */
+    uint16_t cpu;             /* Binary record REC index */
+    uint32_t fmt_id;          /* Binary record format string id */
+    uint64_t timestamp;       /* Binary record system counter */
+} val_log_ring_rec_ts;
 
 /* Struture to capture test state */
 typedef struct {
@@ -130,18 +159,33 @@ typedef struct {
     uint32_t test_progress;
 } val_test_info_ts;
 
+/* Regression state record, committed to NVM as a whole at test boundaries.
+ * Records alternate between two journal slots so that a reset in the middle
+ * of a commit always leaves the previous record intact.
+ * */
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sequence;
+    uint32_t test_num;
+    uint32_t end_test_num;
+    uint32_t test_progress;
+    val_regre_report_ts regre_report;
+    uint32_t checksum;
+} val_regre_journal_ts;
+
+#define VAL_REGRE_JOURNAL_MAGIC        0x52474A4E
+#define VAL_REGRE_JOURNAL_VERSION      0x1
+#define VAL_REGRE_JOURNAL_SLOT_COUNT   2
+
 typedef enum {
     NVM_PLATFORM_RESERVE_INDEX         = 0x0,
-    NVM_CUR_SUITE_NUM_INDEX            = 0x1,
-    NVM_CUR_TEST_NUM_INDEX             = 0x2,
-    NVM_END_TEST_NUM_INDEX             = 0x3,
-    NVM_TEST_PROGRESS_INDEX            = 0x4,
-    NVM_TOTAL_PASS_INDEX               = 0x5,
-    NVM_TOTAL_FAIL_INDEX               = 0x6,
-    NVM_TOTAL_SKIP_INDEX               = 0x7,
-    NVM_TOTAL_ERROR_INDEX              = 0x8,
+    NVM_REGRE_JOURNAL_INDEX            = 0x1,
 } val_nvm_map_index_te;
 
+#define VAL_NVM_JOURNAL_SLOT_OFFSET(slot)  (VAL_NVM_OFFSET(NVM_REGRE_JOURNAL_INDEX) + \
+                                    ((slot) * (uint32_t)sizeof(val_regre_journal_ts)))
+
 /* Test state macros */
 #define TEST_START                 0x01
 #define TEST_PASS                  0x02
@@ -172,16 +216,31 @@ typedef enum {
                                     TEST_STATE_MASK) == TEST_FAIL)
 #define IS_STATUS_FAIL(status)  ((status & TEST_STATUS_CODE_MASK) ? 1 : 0)
 
+/* With BINARY_LOG, host and realm format strings live in .binlog_fmt which
+ * is kept in the ELF for the decoder but not loaded with the image
+ */
+#if defined(BINARY_LOG) && (defined(ACS_HOST_BUILD) || defined(ACS_REALM_BUILD))
+#define VAL_LOG_FMT(x)                                                  \
+    ({ static const char __attribute__((section(".binlog_fmt")))       \
+       val_log_fmt[] = x; val_log_fmt; })
+#else
+#define VAL_LOG_FMT(x)  (x)
+#endif
+
 /* Macro to print the host and secure message and control the verbosity */
 #define LOG(print_verbosity, x, y, z)               \
+    LOG_VAR(print_verbosity, VAL_LOG_FMT(x), y, z)
+
+/* LOG for a format string built or selected at runtime, always printed as text */
+#define LOG_VAR(print_verbosity, x, y, z)           \
    do {                                             \
     if (print_verbosity >= VERBOSITY)               \
         val_common_printf(x, y, z);                        \
     if (print_verbosity == ERROR)                   \
     {                                               \
-        val_common_printf("\t(Check failed at:", 0, 0);    \
-        val_common_printf(__FILE__, 0, 0);                 \
-        val_common_printf(" ,line:%d)\n", __LINE__, 0);    \
+        val_common_printf(VAL_LOG_FMT("\t(Check failed at:"), 0, 0);    \
+        val_common_printf(VAL_LOG_FMT(__FILE__), 0, 0);                 \
+        val_common_printf(VAL_LOG_FMT(" ,line:%d)\n"), __LINE__, 0);    \
     }                                               \
    } while (0);
 
@@ -189,6 +248,7 @@ typedef enum {
 #define VAL_PANIC(x)                               \
    do {                                             \
         LOG(ERROR, x, 0, 0);                        \
+        val_printf_flush();                         \
         pal_terminate_simulation();                 \
    } while (0);
 
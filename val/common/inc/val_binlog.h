@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#ifndef _VAL_BINLOG_H_
+#define _VAL_BINLOG_H_
+
+#include "val.h"
+
+/* Binary log, enabled with BINARY_LOG
+ *
+ * Each host and realm LOG call is stored as a fixed size record instead of
+ * being formatted on the target. LOG places its format string in .binlog_fmt,
+ * a section kept in the image ELF but not loaded, and the string id is its
+ * offset from __BINLOG_FMT_START__. tools/scripts/binlog_decode.py resolves
+ * it against the image ELF and renders the message offline.
+ * Runtime strings (LOG_VAR) and the secure image are still printed as text.
+ * */
+#define VAL_BINLOG_IMAGE_HOST     1
+#define VAL_BINLOG_IMAGE_REALM    2
+#define VAL_BINLOG_IMAGE_SECURE   3
+
+/* Host record buffer depth, oldest records are overwritten when full */
+#define VAL_BINLOG_RECORDS        2048
+
+typedef struct {
+    uint32_t fmt_id;          /* Format string offset in the image .binlog_fmt */
+    uint8_t  image;           /* VAL_BINLOG_IMAGE_* */
+    uint8_t  cpu;             /* Logical cpu (host) or REC index (realm) */
+    uint16_t reserved;
+    uint64_t timestamp;       /* System counter */
+    uint64_t data1;
+    uint64_t data2;
+} val_binlog_rec_ts;
+
+typedef struct {
+    uint32_t head;            /* Next record slot */
+    uint32_t count;           /* Valid records, saturates at VAL_BINLOG_RECORDS */
+    uint64_t dropped;         /* Records overwritten before a dump */
+    s_lock_t lock;
+    val_binlog_rec_ts rec[VAL_BINLOG_RECORDS];
+} val_binlog_ts;
+
+uint32_t val_binlog_fmt_id(const char *msg, uint32_t *fmt_id);
+void val_binlog_fill(val_binlog_rec_ts *rec, uint32_t fmt_id, uint8_t image,
+                     uint64_t data1, uint64_t data2);
+#if defined(ACS_HOST_BUILD)
+void val_binlog_append(val_binlog_rec_ts *rec);
+void val_binlog_dump(void);
+#endif
+
+#endif /* _VAL_BINLOG_H_ */
@@ -59,9 +59,34 @@
 #define CACHE_WRITEBACK_SHIFT     6
 #define CACHE_WRITEBACK_GRANULE   (1 << CACHE_WRITEBACK_SHIFT)
 
+/* Realm image header, emitted by the realm linker script at offset 0 of the
+ * image. Lets the host populate only the used part of PLATFORM_REALM_IMAGE_SIZE.
+ * */
+#define VAL_REALM_IMAGE_MAGIC       0x44484D4C52534341 /* "ACSRLMHD" */
+#define VAL_REALM_IMAGE_HDR_VERSION 1
+#define VAL_REALM_IMAGE_HDR_SIZE    0x20
+
 #define VAL_SWITCH_TO_HOST  5
 #define VAL_REALM_PRINT_MSG 6
 
+/* Host execution contexts
+ *
+ * Context 0 is the serial context. It owns the complete shared region and
+ * heap and is used by the primary cpu and by MP test secondaries.
+ * With PARALLEL_DISPATCH, contexts 1..PLATFORM_CPU_COUNT are used by the cpus
+ * running tests concurrently and each one owns an equal slice of the shared
+ * region, heap and VMID space.
+ * */
+#define VAL_SERIAL_CTX_ID   0
+
+#if defined(PARALLEL_DISPATCH)
+#define VAL_CTX_COUNT       (PLATFORM_CPU_COUNT + 1)
+#else
+#define VAL_CTX_COUNT       1
+#endif
+
+#define VAL_SHARED_REGION_SLICE_SIZE  (PLATFORM_SHARED_REGION_SIZE / PLATFORM_CPU_COUNT)
+
 
 /* ACS VA, IPA, PA mapping
  *
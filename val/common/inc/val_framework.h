@@ -24,10 +24,14 @@ void val_set_security_state_flag(uint64_t state);
 void val_set_running_in_realm_flag(void);
 void *val_get_shared_region_base(void);
 void *val_get_shared_region_base_pa(void);
+uint64_t val_get_shared_region_size(void);
+void val_set_ctx_id(uint32_t ctx_id);
+uint32_t val_get_ctx_id(void);
 void *val_get_shared_region_base_ipa(uint64_t ipa_widt);
 uint64_t val_get_ns_shared_region_base_ipa(uint64_t ipa_width, uint64_t pa);
 void val_common_printf(const char *msg, uint64_t data1, uint64_t data2);
 uint32_t val_printf(const char *msg, uint64_t data1, uint64_t data2);
+void val_printf_flush(void);
 uint32_t val_get_curr_test_num(void);
 void val_set_curr_test_num(uint32_t test_num);
 void val_set_status(uint32_t status);
@@ -36,6 +40,9 @@ uint32_t val_is_current_test(char *testname);
 void val_set_curr_test_name(char *testname);
 uint32_t val_nvm_write(uint32_t offset, void *buffer, size_t size);
 uint32_t val_nvm_read(uint32_t offset, void *buffer, size_t size);
+uint32_t val_nvm_write_blocks(pal_nvm_block_ts *blocks, uint32_t count);
+uint32_t val_nvm_read_blocks(pal_nvm_block_ts *blocks, uint32_t count);
+uint32_t val_nvm_benchmark(void);
 uint32_t val_watchdog_enable(void);
 uint32_t val_watchdog_disable(void);
 void val_ns_wdog_enable(uint32_t ms);
@@ -13,9 +13,13 @@
 int val_memcmp(void *src, void *dest, size_t len);
 void *val_memcpy(void *dst, const void *src, size_t len);
 void val_memset(void *dst, int val, size_t count);
+size_t val_zva_block_size(void);
+void val_zero_range(void *dst, size_t size);
+void val_zero_granule(void *granule);
 char *val_strcat(char *str1, char *str2, size_t output_buff_size);
 int val_strcmp(char *str1, char *str2);
 size_t val_strlen(char *str);
+uint32_t val_libc_benchmark(void);
 void val_assert(const char *e, uint64_t line, const char *file);
 
 #endif /* _VAL_LIBC_H_ */
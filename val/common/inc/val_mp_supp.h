@@ -20,10 +20,15 @@ uint64_t val_get_vmpidr(uint32_t cpu_id);
 void val_init_spinlock(s_lock_t *lock);
 void val_spin_lock(s_lock_t *lock);
 void val_spin_unlock(s_lock_t *lock);
+void val_shared_spin_lock(s_lock_t *lock);
+void val_shared_spin_unlock(s_lock_t *lock);
 void val_init_event(event_t *event);
 void val_send_event(event_t *event);
 void val_send_event_to_all(event_t *event);
 void val_send_event_to(event_t *event, unsigned int cpus_count);
 void val_wait_for_event(event_t *event);
+void val_init_barrier(barrier_t *barrier);
+void val_barrier_wait(barrier_t *barrier, unsigned int cpus_count);
+void val_barrier_arrive(barrier_t *barrier, unsigned int cpus_count);
 
 #endif /* _VAL_MP_SUPP_H_ */
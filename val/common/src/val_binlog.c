@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2025, Arm Limited or its affiliates. All rights reserved.
+ *
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ */
+
+#include "val_binlog.h"
+#include "val_mp_supp.h"
+#include "val_sysreg.h"
+#include "val_timer.h"
+
+#if defined(BINARY_LOG)
+/* Hidden so a PIE image takes their link time offsets PC relative, not from the GOT */
+extern char __BINLOG_FMT_START__[] __attribute__((visibility("hidden")));
+extern char __BINLOG_FMT_END__[] __attribute__((visibility("hidden")));
+
+#if defined(ACS_HOST_BUILD)
+/* Host record buffer, also readable from a memory dump through this symbol */
+val_binlog_ts val_binlog;
+#endif
+
+/**
+ *   @brief    Returns the binary log id of a format string
+ *   @param    msg      - Format string
+ *   @param    fmt_id   - Offset of msg from the start of the image .binlog_fmt
+ *   @return   SUCCESS, or FAILURE for a runtime string which must be logged as text
+**/
+uint32_t val_binlog_fmt_id(const char *msg, uint32_t *fmt_id)
+{
+    uint64_t start = (uint64_t)__BINLOG_FMT_START__;
+    uint64_t end = (uint64_t)__BINLOG_FMT_END__;
+
+    if ((uint64_t)msg < start || (uint64_t)msg >= end)
+        return VAL_ERROR;
+
+    *fmt_id = (uint32_t)((uint64_t)msg - start);
+    return VAL_SUCCESS;
+}
+
+/**
+ *   @brief    Fills a binary log record for the calling cpu
+ *   @param    rec      - Record to fill
+ *   @param    fmt_id   - Format string id
+ *   @param    image    - VAL_BINLOG_IMAGE_* of the caller
+ *   @param    data1    - Value for first format specifier
+ *   @param    data2    - Value for second format specifier
+ *   @return   Void
+**/
+void val_binlog_fill(val_binlog_rec_ts *rec, uint32_t fmt_id, uint8_t image,
+                     uint64_t data1, uint64_t data2)
+{
+    rec->fmt_id = fmt_id;
+    rec->image = image;
+    rec->cpu = (uint8_t)val_get_cpuid(val_read_mpidr());
+    rec->reserved = 0;
+    rec->timestamp = val_read_cntpct_el0();
+    rec->data1 = data1;
+    rec->data2 = data2;
+}
+
+#if defined(ACS_HOST_BUILD)
+/**
+ *   @brief    Appends a record to the host binary log, overwriting the oldest
+ *             record when the buffer is full
+ *   @param    rec      - Record to append
+ *   @return   Void
+**/
+void val_binlog_append(val_binlog_rec_ts *rec)
+{
+    /* Lock needs the MMU, early boot logging is single cpu */
+    bool locked = (val_sctlr_read(2) & SCTLR_M_BIT) != 0;
+
+    if (locked)
+        val_spin_lock(&val_binlog.lock);
+
+    val_binlog.rec[val_binlog.head] = *rec;
+    val_binlog.head = (val_binlog.head + 1) % VAL_BINLOG_RECORDS;
+
+    if (val_binlog.count < VAL_BINLOG_RECORDS)
+        val_binlog.count++;
+    else
+        val_binlog.dropped++;
+
+    if (locked)
+        val_spin_unlock(&val_binlog.lock);
+}
+
+/**
+ *   @brief    Prints the buffered records as hex lines for binlog_decode.py
+ *             and empties the buffer
+ *   @param    Void
+ *   @return   Void
+**/
+void val_binlog_dump(void)
+{
+    val_binlog_rec_ts *rec;
+    uint32_t i, idx;
+    bool locked = (val_sctlr_read(2) & SCTLR_M_BIT) != 0;
+
+    if (locked)
+        val_spin_lock(&val_binlog.lock);
+
+    /* Printed with val_printf directly, these lines must not be logged again */
+    val_printf("BINLOG START %x %x\n", val_binlog.count, val_binlog.dropped);
+    val_printf("BINLOG FREQ %x\n", val_read_cntfrq_el0(), 0);
+
+    idx = (val_binlog.head + VAL_BINLOG_RECORDS - val_binlog.count) % VAL_BINLOG_RECORDS;
+    for (i = 0; i < val_binlog.count; i++)
+    {
+        rec = &val_binlog.rec[(idx + i) % VAL_BINLOG_RECORDS];
+        val_printf("BINLOG %x %x",
+                   (uint64_t)rec->fmt_id | ((uint64_t)rec->image << 32) |
+                   ((uint64_t)rec->cpu << 40), rec->timestamp);
+        val_printf(" %x %x\n", rec->data1, rec->data2);
+    }
+
+    val_printf("BINLOG END\n", 0, 0);
+
+    val_binlog.count = 0;
+    val_binlog.dropped = 0;
+
+    if (locked)
+        val_spin_unlock(&val_binlog.lock);
+}
+#endif
+#endif
@@ -22,6 +22,8 @@ bool val_irq_current(void)
     if (pal_irq_handler_dispatcher())
     {
         LOG(ERROR, "Got unexpected interrupt.\n", 0, 0);
+        /* May be the watchdog about to reset, get the output out first */
+        val_printf_flush();
         return false;
     }
 
@@ -91,6 +93,9 @@ static bool default_sync_current_exception(void)
             }
     }
 
+    /* Buffered output would be lost in the spin or the watchdog reset after it */
+    val_printf_flush();
+
     for (;;)
     {
         /* do nothing */
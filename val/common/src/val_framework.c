@@ -10,14 +10,23 @@
 #include "val_rmm.h"
 #include "val_smc.h"
 #include "val_hvc.h"
+#include "val_mp_supp.h"
+#include "val_binlog.h"
 
 uint64_t security_state;
 static uint64_t realm_thread;
 uint64_t realm_ipa_width;
-uint64_t skip_for_val_logs = 0;
+/* Set while a host test body runs, per context as tests run concurrently */
+uint64_t skip_for_val_logs[VAL_CTX_COUNT];
 bool realm_in_p0 = false;
 bool realm_in_pn = false;
 
+#if defined(PARALLEL_DISPATCH)
+/* Execution context used by each cpu, indexed by logical cpuid */
+static volatile uint32_t cpu_ctx_id[PLATFORM_CPU_COUNT];
+static s_lock_t print_lock;
+#endif
+
 /**
  *   @brief    set the security state
  *   @param    Void
@@ -51,6 +60,44 @@ void *val_get_shared_region_base(void)
         return val_get_shared_region_base_pa();
 }
 
+/**
+ *   @brief    Sets the execution context used by the calling cpu
+ *   @param    ctx_id   - Context id, VAL_SERIAL_CTX_ID or logical cpuid + 1
+ *   @return   Void
+**/
+void val_set_ctx_id(uint32_t ctx_id)
+{
+#if defined(PARALLEL_DISPATCH)
+    cpu_ctx_id[val_get_cpuid(val_read_mpidr())] = ctx_id;
+#else
+    (void)ctx_id;
+#endif
+}
+
+/**
+ *   @brief    Returns the execution context used by the calling cpu
+ *   @param    Void
+ *   @return   Context id
+**/
+uint32_t val_get_ctx_id(void)
+{
+#if defined(PARALLEL_DISPATCH)
+    uint32_t cpuid;
+
+    /* Only host cpus run with a per-cpu context */
+    if (security_state != 1)
+        return VAL_SERIAL_CTX_ID;
+
+    cpuid = val_get_cpuid(val_read_mpidr());
+    if (cpuid >= PLATFORM_CPU_COUNT)
+        return VAL_SERIAL_CTX_ID;
+
+    return cpu_ctx_id[cpuid];
+#else
+    return VAL_SERIAL_CTX_ID;
+#endif
+}
+
 /**
  *   @brief    Returns the base address of the shared region
  *   @param    Void
@@ -58,7 +105,26 @@ void *val_get_shared_region_base(void)
 **/
 void *val_get_shared_region_base_pa(void)
 {
-    return ((void *)(PLATFORM_SHARED_REGION_BASE));
+    uint32_t ctx_id = val_get_ctx_id();
+
+    if (ctx_id == VAL_SERIAL_CTX_ID)
+        return ((void *)(PLATFORM_SHARED_REGION_BASE));
+
+    return ((void *)(PLATFORM_SHARED_REGION_BASE +
+                     (uint64_t)(ctx_id - 1) * VAL_SHARED_REGION_SLICE_SIZE));
+}
+
+/**
+ *   @brief    Returns the size of the shared region owned by the calling cpu
+ *   @param    Void
+ *   @return   Size of the shared region
+**/
+uint64_t val_get_shared_region_size(void)
+{
+    if (val_get_ctx_id() == VAL_SERIAL_CTX_ID)
+        return PLATFORM_SHARED_REGION_SIZE;
+
+    return VAL_SHARED_REGION_SLICE_SIZE;
 }
 
 /**
@@ -96,7 +162,121 @@ uint64_t val_get_ns_shared_region_base_ipa(uint64_t ipa_width, uint64_t pa)
 **/
 uint32_t val_printf(const char *msg, uint64_t data1, uint64_t data2)
 {
+#if defined(PARALLEL_DISPATCH)
+  uint32_t ret;
+
+  /* Keep the lines of the cpus running in parallel from interleaving */
+  val_spin_lock(&print_lock);
+  ret = pal_printf(msg, data1, data2);
+  val_spin_unlock(&print_lock);
+  return ret;
+#else
   return pal_printf(msg, data1, data2);
+#endif
+}
+
+/**
+ *   @brief    Hands a realm message to the host through the shared printf
+ *             location and a host call. Host drains the log ring first.
+ *   @param    msg      - NUL terminated message
+ *   @param    size     - Message size including NUL
+ *   @param    data1    - Value for first format specifier
+ *   @param    data2    - Value for second format specifier
+ *   @return   Void
+**/
+static void val_realm_print_host_call(const char *msg, size_t size,
+                                      uint64_t data1, uint64_t data2)
+{
+    __attribute__((aligned (PAGE_SIZE))) val_print_rsi_host_call_t realm_print;
+
+    /* Write realm message to shared printf location */
+    val_memcpy((char *)(val_get_shared_region_base() + REALM_PRINTF_MSG_OFFSET),
+                (char *)msg, size);
+    *(uint64_t *)(val_get_shared_region_base() + REALM_PRINTF_DATA1_OFFSET) = (uint64_t)data1;
+    *(uint64_t *)(val_get_shared_region_base() + REALM_PRINTF_DATA2_OFFSET) = (uint64_t)data2;
+
+    /* Print from realm through RSI_HOST_CALL */
+    if (realm_in_p0) {
+        realm_print.imm = VAL_REALM_PRINT_MSG;
+        val_smc_call(RSI_HOST_CALL, (uint64_t)&realm_print, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    } else {
+        val_hvc_call(PSI_PRINT_MSG, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    }
+}
+
+/**
+ *   @brief    Copies bytes into the log ring data area, wrapping at its end
+ *   @param    ring_off - Free running ring offset
+ *   @param    src      - Source buffer
+ *   @param    size     - Number of bytes
+ *   @return   Void
+**/
+static void val_log_ring_copy_in(uint32_t ring_off, const void *src, size_t size)
+{
+    uint8_t *data = (uint8_t *)(val_get_shared_region_base() + LOG_RING_DATA_OFFSET);
+    size_t i;
+
+    for (i = 0; i < size; i++)
+        data[(ring_off + i) & (LOG_RING_DATA_SIZE - 1)] = ((const uint8_t *)src)[i];
+}
+
+/**
+ *   @brief    Appends a realm message to the log ring without leaving the realm
+ *   @param    rec      - Record header, len is the message size including NUL
+ *                        or 0 for a binary record
+ *   @param    msg      - NUL terminated message, unused for a binary record
+ *   @return   SUCCESS, or FAILURE if the message must go through a host call
+**/
+static uint32_t val_log_ring_put(val_log_ring_rec_ts *rec, const char *msg)
+{
+    val_log_ring_ts *ring = (val_log_ring_ts *)(val_get_shared_region_base() + LOG_RING_OFFSET);
+    uint32_t rec_size = (uint32_t)sizeof(*rec) + rec->len;
+    uint32_t head;
+
+    /* Ring lock needs the MMU, long messages take the host call path */
+    if (!(read_sctlr_el1() & SCTLR_M_BIT) || rec->len > LOG_RING_MSG_MAX)
+        return VAL_ERROR;
+
+    /* Realms with separate images share the ring, an image local lock would not do */
+    val_shared_spin_lock(&ring->lock);
+
+    head = ring->head;
+    if ((LOG_RING_DATA_SIZE - (head - ring->tail)) < rec_size)
+    {
+        /* Ring full, caller flushes it through a host call */
+        val_shared_spin_unlock(&ring->lock);
+        return VAL_ERROR;
+    }
+
+    val_log_ring_copy_in(head, rec, sizeof(*rec));
+    val_log_ring_copy_in(head + (uint32_t)sizeof(*rec), msg, rec->len);
+
+    /* Publish the record only once its bytes are visible to the host */
+    dmbst();
+    ring->head = head + rec_size;
+
+    val_shared_spin_unlock(&ring->lock);
+    return VAL_SUCCESS;
+}
+
+/**
+ *   @brief    Transmits all buffered print output. In realm this flushes
+ *             the log ring through a host call, in host with BINARY_LOG
+ *             the binary log records are dumped first.
+ *   @param    Void
+ *   @return   Void
+**/
+void val_printf_flush(void)
+{
+    if (security_state == 2)
+        val_realm_print_host_call("", 1, 0, 0);
+    else
+    {
+#if defined(BINARY_LOG) && defined(ACS_HOST_BUILD)
+        val_binlog_dump();
+#endif
+        pal_printf_flush();
+    }
 }
 
 /**
@@ -111,12 +291,53 @@ void val_common_printf(const char *msg, uint64_t data1, uint64_t data2)
     size_t length = 0, msg_security_state_length = 0;
     char msg_security_state[1000] = {0,};
     uint64_t prev_log_state = (*(uint64_t *)(val_get_shared_region_base() + PRINT_OFFSET));
+    val_log_ring_rec_ts rec = {0,};
+#if defined(BINARY_LOG)
+    val_binlog_rec_ts bin_rec;
+    uint32_t fmt_id;
+#endif
 
     if (msg == NULL) {
         LOG(WARN, "\tInvalid Message pointer \n", 0, 0);
         return;
     }
 
+#if defined(BINARY_LOG)
+    /* Format strings from .binlog_fmt are logged as records, the decoder adds the image tag */
+    if (val_binlog_fmt_id(msg, &fmt_id) == VAL_SUCCESS)
+    {
+#if defined(ACS_HOST_BUILD)
+        val_binlog_fill(&bin_rec, fmt_id, VAL_BINLOG_IMAGE_HOST, data1, data2);
+        val_binlog_append(&bin_rec);
+        return;
+#elif defined(ACS_REALM_BUILD)
+        val_binlog_fill(&bin_rec, fmt_id, VAL_BINLOG_IMAGE_REALM, data1, data2);
+        rec.data1 = data1;
+        rec.data2 = data2;
+        rec.len = 0;
+        rec.cpu = bin_rec.cpu;
+        rec.fmt_id = fmt_id;
+        rec.timestamp = bin_rec.timestamp;
+
+        if (val_log_ring_put(&rec, NULL) == VAL_SUCCESS)
+            return;
+
+        /* Ring full, the print host call drains it */
+        val_realm_print_host_call("", 1, 0, 0);
+        if (val_log_ring_put(&rec, NULL) == VAL_SUCCESS)
+            return;
+
+        /* MMU off, the format string is not loaded so only its id can be printed */
+        msg = "\tbinlog fmt_id 0x%x, data1 0x%x\n";
+        data2 = data1;
+        data1 = fmt_id;
+#else
+        (void)bin_rec;
+        (void)fmt_id;
+#endif
+    }
+#endif
+
     while (msg[length] != '\0')
     {
         ++length;
@@ -132,7 +353,7 @@ void val_common_printf(const char *msg, uint64_t data1, uint64_t data2)
         if (prev_log_state != security_state)
         {
             *(uint64_t *)(val_get_shared_region_base() + PRINT_OFFSET) = security_state;
-            if (skip_for_val_logs == 1)
+            if (skip_for_val_logs[val_get_ctx_id()] == 1)
             {
                 val_memcpy(msg_security_state, "HOST : \n", 8);
             }
@@ -165,22 +386,14 @@ void val_common_printf(const char *msg, uint64_t data1, uint64_t data2)
 
     if (security_state == 2)
     {
-        __attribute__((aligned (PAGE_SIZE))) val_print_rsi_host_call_t realm_print;
-            /* Write realm message to shared printf location */
-        val_memcpy((char *)(val_get_shared_region_base() + REALM_PRINTF_MSG_OFFSET),
-                    (char *)msg_security_state,
-                    length+msg_security_state_length+1);
-        *(uint64_t *)(val_get_shared_region_base() + REALM_PRINTF_DATA1_OFFSET) = (uint64_t)data1;
-        *(uint64_t *)(val_get_shared_region_base() + REALM_PRINTF_DATA2_OFFSET) = (uint64_t)data2;
-
-        /* Print from realm through RSI_HOST_CALL */
-    if (realm_in_p0) {
-        realm_print.imm = VAL_REALM_PRINT_MSG;
-        val_smc_call(RSI_HOST_CALL, (uint64_t)&realm_print, 0, 0, 0, 0, 0, 0, 0, 0, 0);
-    } else {
-        val_hvc_call(PSI_PRINT_MSG, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
-    }
-
+        rec.data1 = data1;
+        rec.data2 = data2;
+        rec.len = (uint16_t)(length + msg_security_state_length + 1);
+
+        /* Queue in the log ring, host call only if the ring can't take it */
+        if (val_log_ring_put(&rec, msg_security_state))
+            val_realm_print_host_call(msg_security_state,
+                                      length + msg_security_state_length + 1, data1, data2);
     }
     else {
         val_printf(msg_security_state, data1, data2);
@@ -223,7 +436,8 @@ uint32_t val_is_current_test(char *testname)
       ++length;
     }
 
-    if (val_memcmp((void *)testname, (void *)shared_test_name, length))
+    /* Include the terminator, a longer name sharing the prefix is another test */
+    if (val_memcmp((void *)testname, (void *)shared_test_name, length + 1))
         return VAL_ERROR;
 
     return VAL_SUCCESS;
@@ -310,6 +524,38 @@ uint32_t val_nvm_read(uint32_t offset, void *buffer, size_t size)
       return pal_nvm_read(offset, buffer, size);
 }
 
+/**
+ *   @brief     Writes a list of blocks into non-volatile memory in one call.
+ *   @param     blocks    - Block descriptor list
+ *   @param     count     - Number of descriptors
+ *   @return    SUCCESS/FAILURE
+**/
+uint32_t val_nvm_write_blocks(pal_nvm_block_ts *blocks, uint32_t count)
+{
+      return pal_nvm_write_blocks(blocks, count);
+}
+
+/**
+ *   @brief     Reads a list of blocks from non-volatile memory in one call.
+ *   @param     blocks    - Block descriptor list
+ *   @param     count     - Number of descriptors
+ *   @return    SUCCESS/FAILURE
+**/
+uint32_t val_nvm_read_blocks(pal_nvm_block_ts *blocks, uint32_t count)
+{
+      return pal_nvm_read_blocks(blocks, count);
+}
+
+/**
+ *   @brief     Prints the non-volatile memory transfer rate of the platform.
+ *   @param     void
+ *   @return    SUCCESS/FAILURE
+**/
+uint32_t val_nvm_benchmark(void)
+{
+      return pal_nvm_benchmark();
+}
+
 /**
  *   @brief    Initializes and enable the hardware watchdog timer
  *   @param    void
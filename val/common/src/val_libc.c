@@ -6,6 +6,7 @@
  */
 
 #include "val_libc.h"
+#include "val_sysreg.h"
 
 /**
   @brief  Compare the two input buffer content
@@ -42,6 +43,75 @@ void val_memset(void *dst, int val, size_t count)
   pal_memset(dst, val, count);
 }
 
+/**
+  @brief  Returns the DC ZVA block size usable at the current EL
+  @param  void
+  @return Block size in bytes, 0 when DC ZVA is prohibited or the MMU is off
+**/
+size_t val_zva_block_size(void)
+{
+  uint64_t dczid = read_dczid_el0();
+  uint64_t el = (val_read_current_el() & 0xc) >> 2;
+
+  /* With the MMU off memory is Device, DC ZVA would take an alignment fault */
+  if (!(val_sctlr_read(el) & SCTLR_M_BIT) || (dczid & DCZID_DZP_BIT))
+    return 0;
+
+  /* BS is log2 of the block size in words */
+  return (size_t)4 << ((dczid >> DCZID_BS_SHIFT) & DCZID_BS_MASK);
+}
+
+/**
+  @brief  Zeroes a buffer with DC ZVA for the block aligned body when the
+          MMU is on and DCZID_EL0 allows it, with wide stores otherwise
+  @param  dst   - Pointer to the buffer to zero
+  @param  size  - Number of bytes to zero
+  @return None
+**/
+void val_zero_range(void *dst, size_t size)
+{
+  uint64_t addr = (uint64_t)dst;
+  uint64_t end = addr + size;
+  uint64_t block = val_zva_block_size();
+  uint64_t head;
+
+  if (block && size >= block)
+  {
+    /* Head and tail outside whole blocks take the memset path */
+    head = (addr + block - 1) & ~(block - 1);
+    pal_memset(dst, 0, head - addr);
+
+    for (addr = head; addr + block <= end; addr += block)
+      dczva(addr);
+
+    dst = (void *)addr;
+    size = end - addr;
+  }
+
+  pal_memset(dst, 0, size);
+}
+
+/**
+  @brief  Zeroes a granule, see val_zero_range
+  @param  granule   - Pointer to a PAGE_SIZE buffer
+  @return None
+**/
+void val_zero_granule(void *granule)
+{
+  val_zero_range(granule, PAGE_SIZE);
+}
+
+/**
+  @brief  Checks the libc copy, fill and compare routines and prints their
+          throughput
+  @param  void
+  @return SUCCESS/FAILURE
+**/
+uint32_t val_libc_benchmark(void)
+{
+  return pal_libc_benchmark();
+}
+
 /**
   @brief  Appends the string pointed to by str2 to the
           end of the string pointed to by str1
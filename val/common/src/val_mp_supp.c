@@ -101,7 +101,6 @@ uint64_t val_get_vmpidr(uint32_t cpu_id)
 void val_init_event(event_t *event)
 {
     event->cnt = 0;
-    event->lock.lock = 0;
 }
 
 /* Initialize spinlock */
@@ -122,11 +121,21 @@ void val_spin_unlock(s_lock_t *lock)
     pal_spin_unlock(lock);
 }
 
+/* Lock taken by several images, such as a lock in the shared region */
+void val_shared_spin_lock(s_lock_t *lock)
+{
+    pal_shared_spin_lock(lock);
+}
+
+/* Unlock a lock taken with val_shared_spin_lock */
+void val_shared_spin_unlock(s_lock_t *lock)
+{
+    pal_shared_spin_unlock(lock);
+}
+
 static void send_event_common(event_t *event, unsigned int inc)
 {
-    val_spin_lock(&event->lock);
-    event->cnt += inc;
-    val_spin_unlock(&event->lock);
+    pal_atomic_add(&event->cnt, inc);
 
     //val_dataCacheCleanInvalidateVA((uint64_t)&event->cnt);
     /*
@@ -189,38 +198,94 @@ void val_send_event_to(event_t *event, unsigned int cpus_count)
  */
 void val_wait_for_event(event_t *event)
 {
-    unsigned int event_received = 0;
+    unsigned int event_received = 0, cnt;
 
     LOG(DBG, "Waiting for event %x\n", (uint64_t) event, 0);
     while (!event_received) {
 
         //val_dataCacheInvalidateVA((uint64_t)&event->cnt);
         dsbsy();
+        cnt = event->cnt;
         /* Wait for someone to send an event */
-        if (!event->cnt) {
+        if (!cnt) {
             wfe();
         } else {
-            val_spin_lock(&event->lock);
-
-             /*
-              * Check that the event is still pending and that no
-              * one stole it from us while we were trying to
-              * acquire the lock.
-              */
-            if (event->cnt != 0) {
-                event_received = 1;
-                --event->cnt;
-            }
             /*
-             * No memory barrier is needed here because val_spin_unlock()
-             * issues a Store-Release instruction, which guarantees
-             * that loads and stores appearing in program order
-             * before the Store-Release are observed before the
-             * Store-Release itself.
+             * Take one recipient off the counter, unless another CPU
+             * changed it since it was read. The compare and swap has
+             * acquire semantics, so accesses made after the event are
+             * not observed before it is received.
              */
-            val_spin_unlock(&event->lock);
+            if (pal_atomic_cas(&event->cnt, cnt, cnt - 1) == cnt)
+                event_received = 1;
         }
     }
 
     LOG(DBG, "Event recieved for %x\n", (uint64_t) event, 0);
 }
+
+/*
+ * Initialise a barrier.
+ *   barrier: Address of the barrier to initialise
+ *
+ * Note: This function is not MP-safe, it must be called before any CPU
+ * waits on the barrier.
+ */
+void val_init_barrier(barrier_t *barrier)
+{
+    barrier->count = 0;
+    barrier->sense = 0;
+}
+
+/* Counts the caller in, the last CPU releases the others and gets true */
+static bool val_barrier_count_in(barrier_t *barrier, unsigned int cpus_count)
+{
+    if (pal_atomic_add(&barrier->count, 1) + 1 != cpus_count)
+        return false;
+
+    barrier->count = 0;
+    /* Release, the count reset is observed before the sense flip */
+    pal_atomic_add(&barrier->sense, 1);
+    dsbsy();
+    sev();
+    return true;
+}
+
+/*
+ * Wait until a given number of CPUs have reached a barrier.
+ *   barrier: Address of the variable that acts as a synchronisation object.
+ *   cpus_count: Number of CPUs taking part, including the calling CPU.
+ *
+ * The last CPU to arrive resets the count and flips the sense, which
+ * releases the others. The barrier can be reused straight away, a CPU
+ * entering the next phase waits on the new sense.
+ */
+void val_barrier_wait(barrier_t *barrier, unsigned int cpus_count)
+{
+    unsigned int sense = barrier->sense;
+
+    if (val_barrier_count_in(barrier, cpus_count))
+        return;
+
+    while (barrier->sense == sense)
+    {
+        wfe();
+        dsbsy();
+    }
+
+    /* Accesses after the barrier are not observed before the sense flip */
+    dmbish();
+}
+
+/*
+ * Count the calling CPU in at a barrier without waiting for the others.
+ *   barrier: Address of the barrier.
+ *   cpus_count: Number of CPUs taking part, as given to val_barrier_wait.
+ *
+ * Used on error paths to stand in for CPUs that were never started, so
+ * the CPUs already waiting on the barrier are released.
+ */
+void val_barrier_arrive(barrier_t *barrier, unsigned int cpus_count)
+{
+    (void)val_barrier_count_in(barrier, cpus_count);
+}
@@ -99,6 +99,8 @@ uint64_t val_psci_system_off(void)
 **/
 uint64_t val_psci_system_reset(void)
 {
+    /* Buffered uart output does not survive the reset */
+    pal_printf_flush();
     return (val_smc_call(PSCI_SYSTEM_RESET,
                        0, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
 }
@@ -14,10 +14,52 @@
 #define __ADDR_ALIGN_MASK(a, mask)    (((a) + (mask)) & ~(mask))
 #define ADDR_ALIGN(a, b)              __ADDR_ALIGN_MASK(a, (typeof(a))(b) - 1)
 
+/* Pre-delegated granule pool of each context, kept at the top of the heap
+ * region and outside every heap so recycled granules survive the per-test
+ * heap reset.
+ * */
+#define VAL_HOST_POOL_GRANULES        64
+#define VAL_HOST_POOL_BATCH           16
+#define VAL_HOST_POOL_REGION_SIZE     ((uint64_t)VAL_CTX_COUNT * VAL_HOST_POOL_GRANULES * PAGE_SIZE)
+#define VAL_HOST_POOL_BASE(ctx_id)    (PLATFORM_HEAP_REGION_BASE + VAL_HOST_HEAP_SIZE + \
+                                       (uint64_t)(ctx_id) * VAL_HOST_POOL_GRANULES * PAGE_SIZE)
+
+/* Heap and VMID share of each parallel dispatch context */
+#define VAL_HOST_HEAP_SIZE            (PLATFORM_HEAP_REGION_SIZE - VAL_HOST_POOL_REGION_SIZE)
+#define VAL_HOST_HEAP_SLICE_SIZE      ((VAL_HOST_HEAP_SIZE / PLATFORM_CPU_COUNT) & \
+                                                ~((uint64_t)PAGE_SIZE - 1))
+#define VAL_HOST_VMID_SLICE_SIZE      (256 / VAL_CTX_COUNT)
+
+/* Buddy allocator, blocks are PAGE_SIZE << order and aligned to their size.
+ * The largest order of a context follows its heap size, the 16 bit block
+ * indices keep it below VAL_HOST_ALLOC_ORDERS.
+ * */
+#define VAL_HOST_ALLOC_GRANULES       (PLATFORM_HEAP_REGION_SIZE / PAGE_SIZE)
+#define VAL_HOST_ALLOC_ORDERS         16
+#define VAL_HOST_ALLOC_NONE           0xFFFF
+
+#if (VAL_HOST_ALLOC_GRANULES >= VAL_HOST_ALLOC_NONE)
+#error "Buddy allocator indices too small for PLATFORM_HEAP_REGION_SIZE"
+#endif
+
+/* Peak heap usage above which a test is reported, in percent of the heap
+ * of the context it ran in
+ * */
+#ifndef HEAP_WARN_PERCENT
+#define HEAP_WARN_PERCENT             25
+#endif
+
 void val_host_mem_alloc_init(void);
 void *val_host_mem_alloc(size_t alignment, size_t size);
 void val_host_mem_free(void *ptr);
+void val_host_heap_usage(uint64_t *peak, uint64_t *alloc, uint64_t *size);
 void *mem_alloc(size_t alignment, size_t size);
 uint16_t val_host_get_vmid(void);
+uint64_t val_host_granule_get(void);
+uint64_t val_host_granule_put(uint64_t PA);
+uint64_t val_host_granule_release(uint64_t PA);
+void val_host_granule_pool_refill(void);
+void val_host_granule_pool_undelegated(uint64_t PA);
+void val_host_granule_pool_drain(void);
 
 #endif /* _VAL_HOST_ALLOC_H_ */
@@ -14,11 +14,18 @@
 #include "val_host_alloc.h"
 #include "val_host_mp.h"
 
+/* Number of slowest tests listed in the regression report */
+#define VAL_SLOWEST_TEST_COUNT  10
+
+/* Pages zeroed per method by the startup zero page benchmark */
+#define VAL_HOST_ZERO_BENCH_LOOPS  16
+
 void acs_host_entry(void);
 uint64_t val_host_get_secondary_cpu_entry(void);
 void val_host_main(bool primary_cpu_boot);
 uint32_t val_host_execute_secure_payload(void);
 uint32_t val_host_realm_printf_msg_service(void);
+void val_host_realm_log_drain(void);
 void val_host_set_reboot_flag(void);
 uint32_t val_host_get_last_run_test_info(val_test_info_ts *test_info);
 #endif /* _VAL_HOST_FRAMEWORK_H_ */
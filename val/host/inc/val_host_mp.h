@@ -11,6 +11,38 @@
 #include "val_mp_supp.h"
 #include "val_host_framework.h"
 
+/* Work items a parked cpu can hold before the poster has to wait */
+#define VAL_HOST_WORK_QUEUE_DEPTH   8
+
+typedef uint64_t (*val_host_work_fn_t)(uint64_t arg);
+
+/* Completion of a work item, filled in by the parked cpu that ran it */
+typedef struct {
+    volatile uint32_t done;
+    uint64_t ret;
+} val_host_future_ts;
+
+typedef struct {
+    val_host_work_fn_t fn;
+    uint64_t arg;
+    val_host_future_ts *future;
+} val_host_work_ts;
+
+typedef struct {
+    val_host_work_ts item[VAL_HOST_WORK_QUEUE_DEPTH];
+    volatile uint32_t head;     /* Items taken, written by the parked cpu */
+    volatile uint32_t tail;     /* Items posted, written by the poster */
+    volatile uint32_t parked;
+} __aligned(CACHE_WRITEBACK_GRANULE) val_host_work_queue_ts;
+
 uint64_t val_host_power_on_cpu(uint32_t target_cpuid);
 uint64_t val_host_power_off_cpu(void);
+uint64_t val_host_park_cpu(uint32_t target_cpuid);
+uint64_t val_host_release_cpu(uint32_t target_cpuid);
+bool val_host_is_cpu_parked(uint32_t target_cpuid);
+bool val_host_parked_cpus_idle(void);
+void val_host_park_loop(void);
+uint64_t val_host_post_work(uint32_t target_cpuid, val_host_work_fn_t fn, uint64_t arg,
+                            val_host_future_ts *future);
+uint64_t val_host_wait_future(val_host_future_ts *future);
 #endif /* _VAL_HOST_MP_H_ */
@@ -77,6 +77,15 @@ typedef struct {
     uint64_t pa;
 } val_host_granules_mapped_ts;
 
+/* Header at the start of the realm image, sizes are from the image base */
+typedef struct {
+    uint32_t branch;          /* Branch to the realm entry code */
+    uint32_t version;
+    uint64_t magic;
+    uint64_t load_size;       /* Bytes with loaded contents, page aligned */
+    uint64_t image_size;      /* Loaded bytes plus bss and stacks, page aligned */
+} val_host_realm_image_hdr_ts;
+
 typedef struct {
     /* Test Input start */
     uint64_t flags;
@@ -408,18 +417,91 @@ typedef struct {
     uint64_t tdi_id;
 } val_host_vdev_params_ts;
 
-typedef struct val_host_granule_ts {
-    uint64_t rd;
-    uint32_t state;
-    uint64_t PA;
-    uint64_t ipa;
-    uint64_t level;
-    uint64_t rtt_tree_idx;
-    uint8_t  is_granule_sliced;
-    uint8_t has_auxiliary[VAL_MAX_AUX_PLANES];
-    struct val_host_granule_ts *next;
+/* Granule tracker
+ *
+ * Every heap granule has an entry in a table indexed by
+ * (PA - PLATFORM_HEAP_REGION_BASE) / PAGE_SIZE. Delegated granules are linked
+ * on the NS list of mem_track[0], granules owned by a realm on one of the
+ * RD/RTT/RTT_AUX/REC/DATA lists of that realm. Lists are intrusive and doubly
+ * linked through table indices, insert and remove are O(1). Data granules are
+ * also hashed by (realm, IPA) for the commands which only take an IPA.
+ * Unprotected mappings have no delegated granule and are kept on a per-realm
+ * list keyed by IPA.
+ *
+ * RTT granules are hashed by (realm, IPA, level, tree) as well, which makes
+ * the tracker a shadow of the realm RTTs: the walk level and entry state of an
+ * IPA are found without RMI_RTT_READ_ENTRY. RIPAS is not mirrored.
+ * */
+#define VAL_HOST_GRANULE_COUNT      (PLATFORM_HEAP_REGION_SIZE / PAGE_SIZE)
+#define VAL_HOST_GRANULE_NONE       0xFFFF
+/* Power of two above VAL_HOST_GRANULE_COUNT, shared by the parallel contexts */
+#define VAL_HOST_GRANULE_HASH_SIZE  0x4000
+
+#if (VAL_HOST_GRANULE_COUNT >= VAL_HOST_GRANULE_NONE) || \
+    (VAL_HOST_GRANULE_COUNT >= VAL_HOST_GRANULE_HASH_SIZE)
+#error "Granule tracker indices too small for PLATFORM_HEAP_REGION_SIZE"
+#endif
+
+/* Packed IPA word, granule aligned IPA with the attributes in the low bits */
+#define VAL_HOST_GRANULE_ATTR_MASK   0xFFFULL
+#define VAL_HOST_GRANULE_STATE_SHIFT 0
+#define VAL_HOST_GRANULE_STATE_MASK  0xFULL
+#define VAL_HOST_GRANULE_LEVEL_SHIFT 4
+#define VAL_HOST_GRANULE_LEVEL_MASK  0x7ULL
+#define VAL_HOST_GRANULE_AUX_SHIFT   7
+#define VAL_HOST_GRANULE_AUX_MASK    0x7ULL
+#define VAL_HOST_GRANULE_TREE_SHIFT  10
+#define VAL_HOST_GRANULE_TREE_MASK   0x3ULL
+
+/* Hash key of a table, bit 0 keeps it apart from the IPA key of a data granule */
+#define VAL_HOST_RTT_KEY(ipa, level, tree) \
+    ((ipa) | (((uint64_t)(level) & VAL_HOST_GRANULE_LEVEL_MASK) << VAL_HOST_GRANULE_LEVEL_SHIFT) | \
+     (((uint64_t)(tree) & VAL_HOST_GRANULE_TREE_MASK) << VAL_HOST_GRANULE_TREE_SHIFT) | 1ULL)
+
+/* Starting level of an untracked realm, its tables are looked up with RMI */
+#define VAL_HOST_RTT_START_NONE      0xFF
+
+#define VAL_HOST_GRANULE_FIELD(g, f) \
+    (((g)->ipa >> VAL_HOST_GRANULE_##f##_SHIFT) & VAL_HOST_GRANULE_##f##_MASK)
+#define VAL_HOST_GRANULE_IPA(g)      ((g)->ipa & ~VAL_HOST_GRANULE_ATTR_MASK)
+
+typedef enum {
+    VAL_HOST_GRANULE_LIST_NONE = 0,
+    VAL_HOST_GRANULE_LIST_NS,
+    VAL_HOST_GRANULE_LIST_RD,
+    VAL_HOST_GRANULE_LIST_RTT,
+    VAL_HOST_GRANULE_LIST_RTT_AUX,
+    VAL_HOST_GRANULE_LIST_REC,
+    VAL_HOST_GRANULE_LIST_DATA,
+    VAL_HOST_GRANULE_LIST_COUNT
+} val_host_granule_list_te;
+
+typedef struct {
+    uint64_t ipa;             /* Packed IPA word */
+    uint16_t next;            /* Table index of the next granule on the list */
+    uint16_t prev;
+    uint8_t  realm;           /* mem_track index of the owning list */
+    uint8_t  list;            /* val_host_granule_list_te */
+    uint16_t run;             /* Table index of the run page of a REC, freed with it */
 } val_host_granule_ts;
 
+/* Unprotected mapping nodes come from a fixed slab arena outside the heap,
+ * split between the parallel contexts and rebuilt at every test start.
+ * */
+#define VAL_HOST_UNPROT_NODES       4096
+
+#if (VAL_HOST_UNPROT_NODES >= VAL_HOST_GRANULE_NONE)
+#error "Unprotected mapping arena too large for 16-bit node indices"
+#endif
+
+typedef struct {
+    uint64_t ipa;
+    uint16_t next;            /* Arena index of the next node */
+    uint8_t  level;
+    uint8_t  aux;             /* Bit n set for a live mapping in auxiliary plane n + 1 */
+    uint32_t reserved;
+} val_host_unprot_map_ts;
+
 typedef struct {
     uint64_t src_pa;
     uint64_t target_pa;
@@ -428,30 +510,33 @@ typedef struct {
     uint64_t size;
 } val_data_create_ts;
 
-typedef val_host_granule_ts NS_LL;
-typedef val_host_granule_ts RD_LL;
-typedef val_host_granule_ts RTT_LL;
-typedef val_host_granule_ts RTT_AUX_LL;
-typedef val_host_granule_ts REC_LL;
-typedef val_host_granule_ts DATA_LL;
-typedef val_host_granule_ts VALID_NS_LL;
-
-typedef struct {
-    NS_LL *ns;
-    RD_LL *rd;
-    RTT_LL *rtt;
-    RTT_AUX_LL *rtt_aux;
-    REC_LL *rec;
-    DATA_LL *data;
-    VALID_NS_LL *valid_ns;
-} val_host_granule_type_ts;
-
 typedef struct mem_track {
     uint64_t rd;
-    val_host_granule_type_ts gran_type;
+    uint16_t list[VAL_HOST_GRANULE_LIST_COUNT];   /* List heads */
+    uint16_t valid_ns;                            /* Unprotected mapping list head */
+    uint8_t  rtt_start;                           /* RTT starting level of the realm */
 } val_host_memory_track_ts;
 
-extern val_host_memory_track_ts mem_track[];
+/* Per test heap usage and granule churn of a context. The NS entries count
+ * RMI_GRANULE_DELEGATE and RMI_GRANULE_UNDELEGATE, the other entries count
+ * delegated granules turned into and released from that granule type.
+ * */
+typedef struct {
+    uint64_t heap_peak;                           /* Heap high-water mark in bytes */
+    uint64_t heap_alloc;                          /* Total bytes allocated */
+    uint64_t heap_size;                           /* Heap of the context that ran the test */
+    uint32_t delegated[VAL_HOST_GRANULE_LIST_COUNT];
+    uint32_t undelegated[VAL_HOST_GRANULE_LIST_COUNT];
+} val_host_mem_stats_ts;
+
+typedef struct {
+    int current_realm;
+    uint16_t unprot_free;                         /* Free arena nodes of the context */
+    val_host_memory_track_ts mem_track[VAL_HOST_MAX_REALMS];
+    val_host_mem_stats_ts stats;                  /* Reset with the mem_track lists */
+} val_host_mem_track_ctx_ts;
+
+val_host_mem_track_ctx_ts *val_host_get_mem_track_ctx(void);
 
 uint32_t val_host_map_protected_data(val_host_realm_ts *realm,
                 uint64_t target_pa,
@@ -483,8 +568,13 @@ uint32_t val_host_realm_setup(val_host_realm_ts *realm, bool activate);
 uint32_t val_host_check_realm_exit_host_call(val_host_rec_run_ts *run);
 uint32_t val_host_check_realm_exit_ripas_change(val_host_rec_run_ts *run);
 uint32_t val_host_check_realm_exit_psci(val_host_rec_run_ts *run, uint32_t psci_fid);
-void val_host_add_granule(uint32_t state, uint64_t PA, val_host_granule_ts *node);
+void val_host_add_granule(uint32_t state, uint64_t PA);
 val_host_granule_ts *val_host_find_granule(uint64_t PA);
+bool val_host_is_granule_tracked(uint64_t PA);
+void val_host_update_data_level(uint64_t rd, uint64_t ipa, uint64_t level);
+void val_host_update_rtt_start(uint64_t rd, uint64_t level);
+void val_host_untrack_granule(uint64_t PA);
+void val_host_granule_set_run(uint64_t rec, uint64_t run);
 void val_host_update_granule_state(uint64_t rd,
                         uint32_t state,
                         uint64_t PA,
@@ -492,12 +582,6 @@ void val_host_update_granule_state(uint64_t rd,
                         uint64_t level,
                         uint64_t rtt_tree_idx);
 uint64_t val_host_postamble(void);
-val_host_granule_ts *val_host_remove_granule(val_host_granule_ts **current, uint64_t PA);
-val_host_granule_ts *val_host_remove_data_granule(val_host_granule_ts **current, uint64_t ipa);
-val_host_granule_ts *val_host_remove_rtt_granule(val_host_granule_ts **gran_list_head,
-                                                        uint64_t ipa, uint64_t level);
-val_host_granule_ts *val_host_remove_aux_rtt_granule(val_host_granule_ts **gran_list_head,
-                                                   uint64_t ipa, uint64_t level, uint64_t index);
 int val_host_get_curr_realm(uint64_t rd);
 void val_host_update_destroy_granule_state(uint64_t rd,
                         uint64_t PA,
@@ -506,7 +590,6 @@ void val_host_update_destroy_granule_state(uint64_t rd,
                         uint32_t state,
                         uint32_t gran_list_state,
                         uint64_t rtt_tree_idx);
-uint64_t val_host_destroy_rtt_levels(uint64_t level, int current_realm);
 uint32_t val_host_map_ns_shared_region(val_host_realm_ts *realm, uint64_t size, uint64_t mem_attr);
 int val_host_ripas_init(val_host_realm_ts *realm, uint64_t base,
                 uint64_t top, uint64_t rtt_level, uint64_t rtt_alignment);
@@ -518,6 +601,8 @@ uint32_t val_host_create_rtt_levels(val_host_realm_ts *realm,
 
 uint32_t val_host_map_protected_data_to_realm(val_host_realm_ts *realm,
                                             val_data_create_ts *data_create);
+uint32_t val_host_map_protected_block_to_realm(val_host_realm_ts *realm,
+                                             val_data_create_ts *data_create);
 
 void val_host_realm_params(val_host_realm_ts *realm);
 void val_host_reset_mem_tack(void);
@@ -535,7 +620,6 @@ uint32_t val_host_create_aux_rtt_levels(val_host_realm_ts *realm,
                    uint64_t rtt_max_level,
                    uint64_t rtt_alignmenti,
                    uint64_t index);
-uint64_t val_host_destroy_aux_rtt_levels(uint64_t rtt_level, int current_realm, uint64_t index);
 uint64_t val_host_rtt_level_mapsize(uint64_t rtt_level);
 bool val_host_rmm_supports_planes(void);
 bool val_host_rmm_supports_rtt_tree_single(void);
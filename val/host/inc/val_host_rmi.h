@@ -38,6 +38,27 @@ typedef struct {
     uint64_t higher;
 } val_host_rmi_version_ts;
 
+#if defined(RMI_PROFILE)
+/* Profile slots are indexed by FID - RMI_VERSION, the table is sparse as
+ * the range has unassigned FIDs, which are printed as RMI_UNKNOWN
+ * */
+#define VAL_HOST_RMI_FID_BASE       RMI_VERSION
+#define VAL_HOST_RMI_FID_COUNT      (RMI_MEC_SET_PRIVATE - RMI_VERSION + 1)
+/* log2 latency buckets, last bucket collects everything above */
+#define VAL_HOST_RMI_HIST_BUCKETS   32
+
+typedef struct {
+    uint64_t count;
+    uint64_t min;
+    uint64_t max;
+    uint64_t total;
+    uint32_t hist[VAL_HOST_RMI_HIST_BUCKETS];
+} val_host_rmi_profile_ts;
+
+void val_host_rmi_profile_reset(void);
+void val_host_rmi_profile_dump(void);
+#endif
+
 uint64_t val_host_rmi_version(uint64_t req, val_host_rmi_version_ts *output);
 uint64_t val_host_rmi_features(uint64_t index, uint64_t *value);
 uint64_t val_host_rmi_data_create(uint64_t rd, uint64_t data,
@@ -68,6 +89,9 @@ uint64_t val_host_rmi_rtt_map_unprotected(uint64_t rd, uint64_t ipa,
                   uint64_t level, uint64_t desc);
 uint64_t val_host_rmi_rtt_read_entry(uint64_t rd, uint64_t ipa,
                  uint64_t level, val_host_rtt_entry_ts *rtt);
+/* RTT_READ_ENTRY answered from the granule tracker, see val_host_realm.c */
+uint64_t val_host_shadow_rtt_read_entry(uint64_t rd, uint64_t ipa, uint64_t level,
+                                        val_host_rtt_entry_ts *rtte);
 uint64_t val_host_rmi_rtt_unmap_unprotected(uint64_t rd, uint64_t ipa,
                     uint64_t level, uint64_t *top);
 uint64_t val_host_rmi_rtt_init_ripas(uint64_t rd, uint64_t base,
@@ -7,23 +7,70 @@
 
 #include "val_host_alloc.h"
 #include "val_host_realm.h"
+#include "val_host_rmi.h"
 
 typedef struct {
     uint64_t base;
     uint64_t size;
 } val_host_alloc_region_ts;
 
+typedef struct {
+    uint64_t heap_base;
+    uint64_t heap_top;
+    uint16_t curr_vmid;
+    uint8_t  max_order;           /* Largest block the heap holds */
+    uint16_t free_list[VAL_HOST_ALLOC_ORDERS];          /* Free block heads per order */
+    uint64_t heap_used;           /* Bytes in allocated blocks */
+    uint64_t heap_peak;           /* High-water mark of heap_used since init */
+    uint64_t heap_alloc;          /* Bytes handed out since init */
+} val_host_alloc_ctx_ts;
+
+typedef enum {
+    VAL_HOST_BLOCK_NONE = 0,      /* Inside a block, or outside the context heap */
+    VAL_HOST_BLOCK_FREE,
+    VAL_HOST_BLOCK_USED
+} val_host_block_state_te;
+
+/* Per granule buddy state, only meaningful for the first granule of a block */
+typedef struct {
+    uint16_t next;
+    uint16_t prev;
+    uint16_t pages;               /* Granules in use, the tail of a used block is free */
+    uint8_t  order;
+    uint8_t  state;
+} val_host_alloc_block_ts;
+
+typedef enum {
+    VAL_HOST_POOL_NS = 0,         /* Not delegated, can be refilled */
+    VAL_HOST_POOL_IDLE,           /* Delegated, waiting in the pool */
+    VAL_HOST_POOL_OUT,            /* Delegated, handed out and tracked */
+    VAL_HOST_POOL_LOST            /* Held by a realm, or a delegation change failed */
+} val_host_pool_state_te;
+
+typedef struct {
+    uint16_t idle[VAL_HOST_POOL_GRANULES];      /* Stack of idle granule indices */
+    uint16_t idle_count;
+    uint8_t  state[VAL_HOST_POOL_GRANULES];
+} val_host_granule_pool_ts;
+
 static int number_of_regions;
 
-static uint64_t heap_base;
-static uint64_t heap_top;
-static uint16_t curr_vmid;
+/* Heap and VMID state of each host execution context */
+static val_host_alloc_ctx_ts alloc_ctx[VAL_CTX_COUNT];
+
+/* Kept out of the heap so a stray write to freed memory cannot break the lists */
+static val_host_alloc_block_ts alloc_block[VAL_HOST_ALLOC_GRANULES];
+
+/* Survives val_host_mem_alloc_init, zero initialised means nothing delegated */
+static val_host_granule_pool_ts granule_pool[VAL_CTX_COUNT];
 
 /* get vmid */
 uint16_t val_host_get_vmid(void)
 {
-    curr_vmid = curr_vmid + 1;
-    return curr_vmid;
+    val_host_alloc_ctx_ts *ctx = &alloc_ctx[val_get_ctx_id()];
+
+    ctx->curr_vmid = (uint16_t)(ctx->curr_vmid + 1);
+    return ctx->curr_vmid;
 }
 
 static int val_is_power_of_2(uint32_t n)
@@ -31,6 +78,114 @@ static int val_is_power_of_2(uint32_t n)
     return n && !(n & (n - 1));
 }
 
+static uint16_t val_host_block_idx(uint64_t addr)
+{
+    return (uint16_t)((addr - PLATFORM_HEAP_REGION_BASE) / PAGE_SIZE);
+}
+
+static uint64_t val_host_block_addr(uint16_t idx)
+{
+    return PLATFORM_HEAP_REGION_BASE + (uint64_t)idx * PAGE_SIZE;
+}
+
+static void val_host_block_push(val_host_alloc_ctx_ts *ctx, uint16_t idx, uint8_t order)
+{
+    val_host_alloc_block_ts *block = &alloc_block[idx];
+
+    block->order = order;
+    block->state = VAL_HOST_BLOCK_FREE;
+    block->prev = VAL_HOST_ALLOC_NONE;
+    block->next = ctx->free_list[order];
+    if (block->next != VAL_HOST_ALLOC_NONE)
+        alloc_block[block->next].prev = idx;
+    ctx->free_list[order] = idx;
+}
+
+static void val_host_block_unlink(val_host_alloc_ctx_ts *ctx, uint16_t idx)
+{
+    val_host_alloc_block_ts *block = &alloc_block[idx];
+
+    if (block->prev != VAL_HOST_ALLOC_NONE)
+        alloc_block[block->prev].next = block->next;
+    else
+        ctx->free_list[block->order] = block->next;
+
+    if (block->next != VAL_HOST_ALLOC_NONE)
+        alloc_block[block->next].prev = block->prev;
+
+    block->state = VAL_HOST_BLOCK_NONE;
+}
+
+/**
+ * @brief Returns a free block to its free list, merging it with its free buddies
+ * @param ctx - Allocation context owning the block
+ * @param idx - Block index
+ * @param order - Block order
+ * @return Void
+ **/
+static void val_host_block_free(val_host_alloc_ctx_ts *ctx, uint16_t idx, uint8_t order)
+{
+    uint64_t addr;
+    uint16_t buddy;
+
+    while (order < ctx->max_order)
+    {
+        addr = val_host_block_addr(idx) ^ ((uint64_t)PAGE_SIZE << order);
+        if (addr < ctx->heap_base || addr >= ctx->heap_top)
+            break;
+
+        buddy = val_host_block_idx(addr);
+        if (alloc_block[buddy].state != VAL_HOST_BLOCK_FREE || alloc_block[buddy].order != order)
+            break;
+
+        val_host_block_unlink(ctx, buddy);
+        if (buddy < idx)
+        {
+            alloc_block[idx].state = VAL_HOST_BLOCK_NONE;
+            idx = buddy;
+        }
+        order++;
+    }
+
+    alloc_block[idx].state = VAL_HOST_BLOCK_NONE;
+    val_host_block_push(ctx, idx, order);
+}
+
+/**
+ * @brief Returns the order of the largest aligned block starting at off and
+ *        ending at or before end, in granules from an aligned base
+ * @param off - Start of the block
+ * @param end - Limit of the block
+ * @return - Block order
+ **/
+static uint8_t val_host_block_fit(uint32_t off, uint32_t end)
+{
+    uint8_t order = 0;
+
+    while (!((off >> order) & 1) && off + (2U << order) <= end)
+        order++;
+
+    return order;
+}
+
+/**
+ * @brief Returns the smallest block order holding size bytes at the given alignment
+ * @param alignment - alignment for the address, power of 2
+ * @param size - Size of the region
+ * @return - Block order
+ **/
+static uint8_t val_host_block_order(size_t alignment, size_t size)
+{
+    uint64_t pages = (size + PAGE_SIZE - 1) / PAGE_SIZE;
+    uint8_t order = 0;
+
+    /* Blocks are aligned to their own size */
+    while (((uint64_t)1 << order) < pages || ((uint64_t)PAGE_SIZE << order) < alignment)
+        order++;
+
+    return order;
+}
+
 /**
  * @brief Allocates contiguous memory of requested size(no_of_bytes) and alignment.
  * @param alignment - alignment for the address. It must be in power of 2.
@@ -40,20 +195,50 @@ static int val_is_power_of_2(uint32_t n)
  **/
 void *mem_alloc(size_t alignment, size_t size)
 {
-    uint64_t addr;
+    val_host_alloc_ctx_ts *ctx = &alloc_ctx[val_get_ctx_id()];
+    uint8_t order = val_host_block_order(alignment, size);
+    uint8_t k = order;
+    uint32_t pages, off;
+    uint16_t idx;
 
-    addr = ADDR_ALIGN(heap_base, alignment);
-    size += addr - heap_base;
+    /* Smallest free block which fits, single granules come straight off list 0 */
+    while (k <= ctx->max_order && ctx->free_list[k] == VAL_HOST_ALLOC_NONE)
+        k++;
 
-    if ((heap_top - heap_base) < size)
+    if (k > ctx->max_order)
     {
        LOG(ERROR, "Not enough space available\n", 0, 0);
        return NULL;
     }
 
-    heap_base += size;
+    idx = ctx->free_list[k];
+    val_host_block_unlink(ctx, idx);
+
+    /* Split, returning the upper halves to the free lists */
+    while (k > order)
+    {
+        k--;
+        val_host_block_push(ctx, (uint16_t)(idx + (1U << k)), k);
+    }
+
+    /* Only the granules asked for are used, the tail goes back to the free lists */
+    pages = size ? (uint32_t)((size + PAGE_SIZE - 1) / PAGE_SIZE) : 1;
+    for (off = pages; off < (1U << order); off += 1U << k)
+    {
+        k = val_host_block_fit(off, 1U << order);
+        val_host_block_push(ctx, (uint16_t)(idx + off), k);
+    }
+
+    alloc_block[idx].order = order;
+    alloc_block[idx].pages = (uint16_t)pages;
+    alloc_block[idx].state = VAL_HOST_BLOCK_USED;
+
+    ctx->heap_alloc += (uint64_t)pages * PAGE_SIZE;
+    ctx->heap_used += (uint64_t)pages * PAGE_SIZE;
+    if (ctx->heap_used > ctx->heap_peak)
+        ctx->heap_peak = ctx->heap_used;
 
-    return (void *)addr;
+    return (void *)val_host_block_addr(idx);
 }
 
 /**
@@ -63,10 +248,80 @@ void *mem_alloc(size_t alignment, size_t size)
  **/
 void val_host_mem_alloc_init(void)
 {
-    heap_base = PLATFORM_HEAP_REGION_BASE;
-    heap_top = PLATFORM_HEAP_REGION_BASE + PLATFORM_HEAP_REGION_SIZE;
+    uint32_t ctx_id = val_get_ctx_id();
+    val_host_alloc_ctx_ts *ctx = &alloc_ctx[ctx_id];
+    val_host_granule_ts *granule;
+    uint64_t addr;
+    uint32_t i;
+    uint8_t order;
+
+    if (ctx_id == VAL_SERIAL_CTX_ID)
+    {
+        ctx->heap_base = PLATFORM_HEAP_REGION_BASE;
+        ctx->heap_top = PLATFORM_HEAP_REGION_BASE + VAL_HOST_HEAP_SIZE;
+        ctx->curr_vmid = 0;
+    } else {
+        /* Parallel context owns a slice of the heap and of the VMID space */
+        ctx->heap_base = PLATFORM_HEAP_REGION_BASE + (ctx_id - 1) * VAL_HOST_HEAP_SLICE_SIZE;
+        ctx->heap_top = ctx->heap_base + VAL_HOST_HEAP_SLICE_SIZE;
+        ctx->curr_vmid = (uint16_t)((ctx_id - 1) * VAL_HOST_VMID_SLICE_SIZE);
+    }
     number_of_regions = 0;
-    curr_vmid = 0;
+
+    /* Largest block fitting in the heap of the context */
+    ctx->max_order = 0;
+    while (ctx->max_order + 1 < VAL_HOST_ALLOC_ORDERS &&
+           ((uint64_t)PAGE_SIZE << (ctx->max_order + 1)) <= ctx->heap_top - ctx->heap_base)
+        ctx->max_order++;
+
+    ctx->heap_used = 0;
+    ctx->heap_peak = 0;
+    ctx->heap_alloc = 0;
+
+    /*
+     * Pool granules the previous test kept, as the tracker still sees them:
+     * delegated and unused ones go back to idle, ones a live realm holds are
+     * lost until a refill retries them, any other is undelegated.
+     */
+    for (i = 0; i < VAL_HOST_POOL_GRANULES; i++)
+    {
+        if (granule_pool[ctx_id].state[i] != VAL_HOST_POOL_OUT)
+            continue;
+
+        addr = VAL_HOST_POOL_BASE(ctx_id) + (uint64_t)i * PAGE_SIZE;
+        granule = val_host_find_granule(addr);
+        if (granule != NULL && VAL_HOST_GRANULE_FIELD(granule, STATE) == GRANULE_DELEGATED)
+        {
+            val_host_untrack_granule(addr);
+            granule_pool[ctx_id].state[i] = VAL_HOST_POOL_IDLE;
+            granule_pool[ctx_id].idle[granule_pool[ctx_id].idle_count++] = (uint16_t)i;
+        } else if (granule != NULL || !val_host_is_granule_tracked(addr)) {
+            /* Undelegation marks the slot NS through the tracker hook */
+            if (val_host_rmi_granule_undelegate(addr))
+                granule_pool[ctx_id].state[i] = VAL_HOST_POOL_LOST;
+        } else {
+            granule_pool[ctx_id].state[i] = VAL_HOST_POOL_LOST;
+        }
+    }
+
+    for (order = 0; order < VAL_HOST_ALLOC_ORDERS; order++)
+        ctx->free_list[order] = VAL_HOST_ALLOC_NONE;
+
+    val_memset(&alloc_block[val_host_block_idx(ctx->heap_base)], 0,
+               ((ctx->heap_top - ctx->heap_base) / PAGE_SIZE) * sizeof(val_host_alloc_block_ts));
+
+    /* Carve the heap into the largest blocks aligned to their own size */
+    addr = ctx->heap_base;
+    while (addr < ctx->heap_top)
+    {
+        order = ctx->max_order;
+        while (order && ((addr & (((uint64_t)PAGE_SIZE << order) - 1)) ||
+                         (addr + ((uint64_t)PAGE_SIZE << order)) > ctx->heap_top))
+            order--;
+
+        val_host_block_push(ctx, val_host_block_idx(addr), order);
+        addr += (uint64_t)PAGE_SIZE << order;
+    }
 }
 
 /**
@@ -92,22 +347,316 @@ void *val_host_mem_alloc(size_t alignment, size_t size)
     return NULL;
   }
 
-  size += alignment - 1;
+  if (val_host_block_order(alignment, size) > alloc_ctx[val_get_ctx_id()].max_order)
+  {
+    LOG(ERROR, "size 0x%x exceeds the largest heap block\n", size, 0);
+    return NULL;
+  }
+
   addr = mem_alloc(alignment, size);
 
   return addr;
 }
 
 /**
- * Free the memory for given memory address
- * Currently acs code is initialisazing from base for every test,
- * the regions data structure is internal and below code only setting to zero
- * not actually freeing memory.
+ * @brief Returns a block from val_host_mem_alloc/mem_alloc to the heap, merging it
+ *        with its free buddies. Granules the RMM still owns are not reclaimed.
+ * @param ptr - Base address returned by the allocator
+ * @return Void
  **/
 void val_host_mem_free(void *ptr)
 {
+  val_host_alloc_ctx_ts *ctx = &alloc_ctx[val_get_ctx_id()];
+  uint64_t addr = (uint64_t)ptr, size, offset;
+  uint32_t pages, off;
+  uint16_t idx;
+  uint8_t order;
+
   if (!ptr)
     return;
 
-  return;
+  if (addr < ctx->heap_base || addr >= ctx->heap_top || (addr & (PAGE_SIZE - 1)) ||
+      alloc_block[val_host_block_idx(addr)].state != VAL_HOST_BLOCK_USED)
+  {
+    LOG(ERROR, "Invalid free, addr=0x%x\n", addr, 0);
+    return;
+  }
+
+  idx = val_host_block_idx(addr);
+  pages = alloc_block[idx].pages;
+  size = (uint64_t)pages * PAGE_SIZE;
+
+  /* Reusing a delegated granule would fault on the first host access */
+  for (offset = 0; offset < size; offset += PAGE_SIZE)
+  {
+    if (val_host_is_granule_tracked(addr + offset))
+    {
+      LOG(WARN, "Free of delegated granule 0x%x, block not reclaimed\n", addr + offset, 0);
+      return;
+    }
+  }
+
+  ctx->heap_used -= size;
+  alloc_block[idx].state = VAL_HOST_BLOCK_NONE;
+
+  /* Used granules go back as the aligned blocks they split into, merging with the free tail */
+  for (off = 0; off < pages; off += 1U << order)
+  {
+    order = val_host_block_fit(off, pages);
+    val_host_block_free(ctx, (uint16_t)(idx + off), order);
+  }
+}
+
+/**
+ * @brief Returns the heap usage of the calling context since val_host_mem_alloc_init
+ * @param peak - Filled with the high-water mark of allocated bytes
+ * @param alloc - Filled with the total bytes allocated, freed blocks included
+ * @param size - Filled with the size of the heap slice of the context
+ * @return Void
+ **/
+void val_host_heap_usage(uint64_t *peak, uint64_t *alloc, uint64_t *size)
+{
+  val_host_alloc_ctx_ts *ctx = &alloc_ctx[val_get_ctx_id()];
+
+  *peak = ctx->heap_peak;
+  *alloc = ctx->heap_alloc;
+  *size = ctx->heap_top - ctx->heap_base;
+}
+
+/**
+ * @brief Delegates up to VAL_HOST_POOL_BATCH pool granules of the calling context.
+ *        Lost granules are retried, they come back once the realm holding
+ *        them is gone. Called between tests so the delegations stay out of
+ *        the test time.
+ * @param void
+ * @return Void
+ **/
+void val_host_granule_pool_refill(void)
+{
+  uint32_t ctx_id = val_get_ctx_id();
+  val_host_granule_pool_ts *pool = &granule_pool[ctx_id];
+  uint64_t PA;
+  uint16_t i, batch = 0;
+
+  for (i = 0; i < VAL_HOST_POOL_GRANULES && batch < VAL_HOST_POOL_BATCH; i++)
+  {
+    if (pool->state[i] != VAL_HOST_POOL_NS && pool->state[i] != VAL_HOST_POOL_LOST)
+      continue;
+
+    PA = VAL_HOST_POOL_BASE(ctx_id) + (uint64_t)i * PAGE_SIZE;
+
+    /* Still delegated, or NS after a failed delegation, which fails here */
+    if (pool->state[i] == VAL_HOST_POOL_LOST)
+      (void)val_host_rmi_granule_undelegate(PA);
+
+    if (val_host_rmi_granule_delegate(PA))
+    {
+      if (pool->state[i] == VAL_HOST_POOL_NS)
+        LOG(WARN, "Pool granule delegation failed, PA=0x%x\n", PA, 0);
+      pool->state[i] = VAL_HOST_POOL_LOST;
+      continue;
+    }
+
+    /* Idle granules are owned by the pool, not by the tracker */
+    val_host_untrack_granule(PA);
+    pool->state[i] = VAL_HOST_POOL_IDLE;
+    pool->idle[pool->idle_count++] = i;
+    batch++;
+  }
+}
+
+/**
+ * @brief Returns a delegated granule, from the pool of the calling context
+ *        when possible, otherwise allocated from the heap and delegated.
+ * @param void
+ * @return Granule PA on the tracker NS list, or 0 on failure
+ **/
+uint64_t val_host_granule_get(void)
+{
+  uint32_t ctx_id = val_get_ctx_id();
+  val_host_granule_pool_ts *pool = &granule_pool[ctx_id];
+  uint64_t PA;
+  uint16_t i;
+
+  if (pool->idle_count == 0)
+    val_host_granule_pool_refill();
+
+  if (pool->idle_count)
+  {
+    i = pool->idle[--pool->idle_count];
+    pool->state[i] = VAL_HOST_POOL_OUT;
+    PA = VAL_HOST_POOL_BASE(ctx_id) + (uint64_t)i * PAGE_SIZE;
+    val_host_add_granule(GRANULE_DELEGATED, PA);
+    return PA;
+  }
+
+  PA = (uint64_t)mem_alloc(PAGE_SIZE, PAGE_SIZE);
+  if (!PA)
+    return 0;
+
+  if (val_host_rmi_granule_delegate(PA))
+  {
+    LOG(ERROR, "Granule delegation failed, PA=0x%x\n", PA, 0);
+    val_host_mem_free((void *)PA);
+    return 0;
+  }
+
+  return PA;
+}
+
+/**
+ * @brief Releases a delegated granule which is back on the tracker NS list.
+ *        Pool granules return to the pool still delegated, any other granule
+ *        is undelegated and a single granule heap block is freed.
+ * @param PA - Granule address
+ * @return RMI status of the undelegation, RMI_SUCCESS for a pool granule
+ **/
+uint64_t val_host_granule_put(uint64_t PA)
+{
+  uint32_t ctx_id = val_get_ctx_id();
+  val_host_granule_pool_ts *pool = &granule_pool[ctx_id];
+  uint64_t ret, base = VAL_HOST_POOL_BASE(ctx_id);
+  uint16_t i, idx;
+
+  if (PA >= base && PA < base + VAL_HOST_POOL_GRANULES * PAGE_SIZE)
+  {
+    i = (uint16_t)((PA - base) / PAGE_SIZE);
+    if (pool->state[i] == VAL_HOST_POOL_OUT)
+    {
+      val_host_untrack_granule(PA);
+      pool->state[i] = VAL_HOST_POOL_IDLE;
+      pool->idle[pool->idle_count++] = i;
+      return RMI_SUCCESS;
+    }
+  }
+
+  ret = val_host_rmi_granule_undelegate(PA);
+  if (ret)
+    return ret;
+
+  idx = val_host_block_idx(PA);
+  if (PA >= alloc_ctx[ctx_id].heap_base && PA < alloc_ctx[ctx_id].heap_top &&
+      alloc_block[idx].state == VAL_HOST_BLOCK_USED && alloc_block[idx].pages == 1)
+    val_host_mem_free((void *)PA);
+
+  return RMI_SUCCESS;
+}
+
+/**
+ * @brief Releases a granule at realm teardown. On top of val_host_granule_put,
+ *        the heap block holding it (realm image, starting RTTs, DATA backing
+ *        memory) is freed once none of its granules is tracked any more.
+ * @param PA - Granule address
+ * @return RMI status of the undelegation
+ **/
+uint64_t val_host_granule_release(uint64_t PA)
+{
+  val_host_alloc_ctx_ts *ctx = &alloc_ctx[val_get_ctx_id()];
+  uint64_t ret, base;
+  uint32_t pages, off;
+  uint16_t idx, head;
+  uint8_t order;
+
+  ret = val_host_granule_put(PA);
+  if (ret || PA < ctx->heap_base || PA >= ctx->heap_top)
+    return ret;
+
+  /* Blocks are aligned to their own size, the first used head covering PA holds it */
+  idx = val_host_block_idx(PA);
+  for (order = 1; order <= ctx->max_order; order++)
+  {
+    head = (uint16_t)(idx & ~((1U << order) - 1));
+    if (alloc_block[head].state == VAL_HOST_BLOCK_USED && alloc_block[head].order == order &&
+        idx < head + alloc_block[head].pages)
+      break;
+  }
+
+  if (order > ctx->max_order)
+    return RMI_SUCCESS;
+
+  /* Teardown goes up the PA range, start at the next granule to stop early */
+  base = val_host_block_addr(head);
+  pages = alloc_block[head].pages;
+  for (off = 1; off < pages; off++)
+  {
+    if (val_host_is_granule_tracked(base + (uint64_t)((idx - head + off) % pages) * PAGE_SIZE))
+      return RMI_SUCCESS;
+  }
+
+  val_host_mem_free((void *)base);
+  return RMI_SUCCESS;
+}
+
+/**
+ * @brief Tracker hook for RMI_GRANULE_UNDELEGATE, a pool granule undelegated
+ *        by a test becomes available for the next refill
+ * @param PA - Granule address
+ * @return Void
+ **/
+void val_host_granule_pool_undelegated(uint64_t PA)
+{
+  uint32_t ctx_id = val_get_ctx_id();
+  val_host_granule_pool_ts *pool = &granule_pool[ctx_id];
+  uint64_t base = VAL_HOST_POOL_BASE(ctx_id);
+  uint16_t i, j;
+
+  if (PA < base || PA >= base + VAL_HOST_POOL_GRANULES * PAGE_SIZE)
+    return;
+
+  i = (uint16_t)((PA - base) / PAGE_SIZE);
+  if (pool->state[i] == VAL_HOST_POOL_IDLE)
+  {
+    for (j = 0; j < pool->idle_count; j++)
+    {
+      if (pool->idle[j] == i)
+      {
+        pool->idle[j] = pool->idle[--pool->idle_count];
+        break;
+      }
+    }
+  }
+
+  pool->state[i] = VAL_HOST_POOL_NS;
+}
+
+/**
+ * @brief Undelegates the delegated granules of every context pool, called
+ *        once at the end of the regression. Granules a realm still holds
+ *        stay in Realm PAS and are counted.
+ * @param void
+ * @return Void
+ **/
+void val_host_granule_pool_drain(void)
+{
+  val_host_granule_pool_ts *pool;
+  uint64_t PA;
+  uint32_t ctx_id, lost = 0;
+  uint16_t i;
+
+  for (ctx_id = 0; ctx_id < VAL_CTX_COUNT; ctx_id++)
+  {
+    pool = &granule_pool[ctx_id];
+    pool->idle_count = 0;
+
+    for (i = 0; i < VAL_HOST_POOL_GRANULES; i++)
+    {
+      if (pool->state[i] == VAL_HOST_POOL_NS)
+        continue;
+
+      PA = VAL_HOST_POOL_BASE(ctx_id) + (uint64_t)i * PAGE_SIZE;
+      if (val_host_rmi_granule_undelegate(PA))
+      {
+        /* Undelegate fails on a granule already NS, only idle ones are known delegated */
+        if (pool->state[i] == VAL_HOST_POOL_IDLE)
+          LOG(WARN, "Pool granule undelegation failed, PA=0x%x\n", PA, 0);
+        pool->state[i] = VAL_HOST_POOL_LOST;
+        lost++;
+        continue;
+      }
+      pool->state[i] = VAL_HOST_POOL_NS;
+    }
+  }
+
+  if (lost)
+    LOG(WARN, "%d pool granules could not be undelegated\n", lost, 0);
 }
@@ -29,7 +29,7 @@ uint64_t create_mapping(uint64_t ipa, bool ripas_init, uint64_t rd1)
     val_host_rtt_entry_ts rtte;
 
     /* Try a maximum walk and check where to create the next table entry */
-    if (val_host_rmi_rtt_read_entry(rd, ipa, MAP_LEVEL, &rtte)) {
+    if (val_host_shadow_rtt_read_entry(rd, ipa, MAP_LEVEL, &rtte)) {
         LOG(ERROR, "\tReadEntry query failed!", 0, 0);
         return VAL_ERROR;
     }
@@ -91,23 +91,17 @@ uint64_t create_mapping(uint64_t ipa, bool ripas_init, uint64_t rd1)
 
 uint64_t val_host_delegate_granule(void)
 {
-    /* Allocate a src granule*/
-    uint64_t *gran = val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    /* Take a delegated granule from the pool, or allocate and delegate one */
+    uint64_t gran = val_host_granule_get();
 
-    if (gran != NULL) {
-        if (val_host_rmi_granule_delegate((uint64_t)gran)) {
-            LOG(ERROR, "\tError! granule couldn't be delegated!\n", 0, 0);
-            return VAL_ERROR;
-        } else {
-            LOG(DBG, "\tallocation: granule @ address: %x\n",
-                (uint64_t)gran, 0);
-        }
-    } else {
-        LOG(ERROR, "\tError! granule couldn't be allocated!\n", 0, 0);
+    if (!gran) {
+        LOG(ERROR, "\tError! granule couldn't be delegated!\n", 0, 0);
         return VAL_ERROR;
     }
 
-    return (uint64_t)gran;
+    LOG(DBG, "\tallocation: granule @ address: %x\n", gran, 0);
+
+    return gran;
 }
 
 uint64_t val_host_undelegate_granule(void)
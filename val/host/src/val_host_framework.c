@@ -12,10 +12,174 @@
 #include "pal_interfaces.h"
 #include "val.h"
 #include "val_host_memory.h"
+#include "val_timer.h"
+#include "val_host_rmi.h"
+#include "val_binlog.h"
 
 extern const uint32_t  total_tests;
 extern const test_db_t test_list[];
-extern uint64_t skip_for_val_logs;
+extern test_timing_t test_timing[];
+extern val_host_mem_stats_ts test_mem_stats[];
+extern uint64_t skip_for_val_logs[VAL_CTX_COUNT];
+
+#if defined(PARALLEL_DISPATCH)
+/* Parallel dispatch state shared by the cpus running tests concurrently */
+typedef struct {
+    s_lock_t lock;
+    volatile uint32_t next_test;
+    uint32_t end_test;
+    val_host_future_ts cpu_done[PLATFORM_CPU_COUNT];
+    val_regre_report_ts report[PLATFORM_CPU_COUNT];
+} val_host_parallel_ts;
+
+static val_host_parallel_ts parallel;
+#endif
+
+/* In-RAM regression state, mirrored in NVM by val_host_regre_journal_commit */
+static val_regre_journal_ts regre_state;
+
+/**
+ *   @brief    Computes the checksum of a regression journal record
+ *   @param    record       -   Journal record
+ *   @return   Checksum of all fields preceding the checksum field
+**/
+static uint32_t val_host_regre_journal_checksum(val_regre_journal_ts *record)
+{
+    uint32_t *word = (uint32_t *)record;
+    uint32_t i, sum = 0;
+
+    for (i = 0; i < offsetof(val_regre_journal_ts, checksum) / sizeof(uint32_t); i++)
+        sum = ((sum << 5) | (sum >> 27)) ^ word[i];
+
+    return ~sum;
+}
+
+/**
+ *   @brief    Writes the in-RAM regression state as a single NVM record
+ *   @param    void
+ *   @return   SUCCESS/FAILURE
+**/
+static uint32_t val_host_regre_journal_commit(void)
+{
+    regre_state.magic = VAL_REGRE_JOURNAL_MAGIC;
+    regre_state.version = VAL_REGRE_JOURNAL_VERSION;
+    regre_state.sequence++;
+    regre_state.checksum = val_host_regre_journal_checksum(&regre_state);
+
+    return val_nvm_write(VAL_NVM_JOURNAL_SLOT_OFFSET(regre_state.sequence %
+                                                     VAL_REGRE_JOURNAL_SLOT_COUNT),
+                         &regre_state, sizeof(regre_state));
+}
+
+/**
+ *   @brief    Loads the most recent valid journal record into the in-RAM state
+ *   @param    void
+ *   @return   SUCCESS if a valid record is found, FAILURE otherwise
+**/
+static uint32_t val_host_regre_journal_load(void)
+{
+    val_regre_journal_ts record;
+    uint32_t slot, found = 0;
+
+    val_memset(&regre_state, 0, sizeof(regre_state));
+
+    for (slot = 0; slot < VAL_REGRE_JOURNAL_SLOT_COUNT; slot++)
+    {
+        if (val_nvm_read(VAL_NVM_JOURNAL_SLOT_OFFSET(slot), &record, sizeof(record)))
+            return VAL_ERROR;
+
+        if (record.magic != VAL_REGRE_JOURNAL_MAGIC ||
+            record.version != VAL_REGRE_JOURNAL_VERSION ||
+            record.checksum != val_host_regre_journal_checksum(&record))
+            continue;
+
+        /* Newest record wins, sequence wrap safe */
+        if (!found || (int32_t)(record.sequence - regre_state.sequence) > 0)
+        {
+            regre_state = record;
+            found = 1;
+        }
+    }
+
+    return found ? VAL_SUCCESS : VAL_ERROR;
+}
+
+/* Log ring consumer of each shared region context, set while a cpu drains it */
+static volatile uint32_t log_drain_busy[VAL_CTX_COUNT];
+
+/**
+ *   @brief    Prints and consumes all records queued by the realm in the log ring.
+ *             The ring has a single consumer, a cpu finding another one draining
+ *             the same ring leaves the records to it.
+ *   @param    void
+ *   @return   void
+**/
+void val_host_realm_log_drain(void)
+{
+    val_log_ring_ts *ring = (val_log_ring_ts *)(val_get_shared_region_base() + LOG_RING_OFFSET);
+    uint8_t *data = (uint8_t *)(val_get_shared_region_base() + LOG_RING_DATA_OFFSET);
+    volatile uint32_t *busy = &log_drain_busy[val_get_ctx_id()];
+    char msg[LOG_RING_MSG_MAX];
+    val_log_ring_rec_ts rec;
+    uint32_t head, tail, i;
+#if defined(BINARY_LOG)
+    val_binlog_rec_ts bin_rec;
+#endif
+
+    if (pal_atomic_cas(busy, 0, 1) != 0)
+        return;
+
+    head = ring->head;
+    tail = ring->tail;
+
+    /* Record bytes are read only after the head that published them */
+    dmbld();
+
+    while (tail != head)
+    {
+        for (i = 0; i < sizeof(rec); i++)
+            ((uint8_t *)&rec)[i] = data[(tail + i) & (LOG_RING_DATA_SIZE - 1)];
+        tail += (uint32_t)sizeof(rec);
+
+#if defined(BINARY_LOG)
+        if (rec.len == 0)
+        {
+            bin_rec.fmt_id = rec.fmt_id;
+            bin_rec.image = VAL_BINLOG_IMAGE_REALM;
+            bin_rec.cpu = (uint8_t)rec.cpu;
+            bin_rec.reserved = 0;
+            bin_rec.timestamp = rec.timestamp;
+            bin_rec.data1 = rec.data1;
+            bin_rec.data2 = rec.data2;
+            val_binlog_append(&bin_rec);
+            continue;
+        }
+#endif
+
+        if (rec.len == 0 || rec.len > LOG_RING_MSG_MAX)
+        {
+            LOG(ERROR, "\tCorrupted realm log ring\n", 0, 0);
+            tail = head;
+            break;
+        }
+
+        for (i = 0; i < rec.len; i++)
+            msg[i] = (char)data[(tail + i) & (LOG_RING_DATA_SIZE - 1)];
+        msg[rec.len - 1] = '\0';
+        tail += rec.len;
+
+        val_printf(msg, rec.data1, rec.data2);
+    }
+
+    /* Hand the space back to the realm once the records are consumed */
+    dmbsy();
+    ring->tail = tail;
+
+    /* Release the consumer, ordered after the tail by the barrier above */
+    dmbsy();
+    *busy = 0;
+}
+
 /**
  *   @brief    Read realm message from shared printf location and print them using uart
  *   @param    void
@@ -23,6 +187,9 @@ extern uint64_t skip_for_val_logs;
 **/
 uint32_t val_host_realm_printf_msg_service(void)
 {
+    /* Queued records precede the message, also frees the ring for the realm */
+    val_host_realm_log_drain();
+
     /* Read realm message from shared printf location and print them using uart */
     return val_printf((char *)(val_get_shared_region_base() + REALM_PRINTF_MSG_OFFSET),
                 *(uint64_t *)(val_get_shared_region_base() + REALM_PRINTF_DATA1_OFFSET),
@@ -49,6 +216,105 @@ uint64_t val_host_get_secondary_cpu_entry(void)
     return (uint64_t)&acs_host_entry;
 }
 
+/**
+ *   @brief    Returns true when PMUv3 is implemented
+ *   @param    void
+ *   @return   true/false
+**/
+static bool val_host_has_pmu(void)
+{
+    uint64_t pmuver = VAL_EXTRACT_BITS(read_id_aa64dfr0_el1(), ID_AA64DFR0_EL1_PMUVer_SHIFT,
+                        (ID_AA64DFR0_EL1_PMUVer_SHIFT + ID_AA64DFR0_EL1_PMUVer_WIDTH - 1));
+
+    return pmuver != 0 && pmuver != 0xF;
+}
+
+/**
+ *   @brief    Starts 64-bit cycle counting at EL2, done once per boot
+ *   @param    void
+ *   @return   void
+**/
+static void val_host_cycle_counter_enable(void)
+{
+    if (!val_host_has_pmu())
+        return;
+
+    write_pmccfiltr_el0(PMCCFILTR_EL0_NSH_BIT);
+    write_pmcntenset_el0(read_pmcntenset_el0() | PMCNTENSET_EL0_C_BIT);
+    write_pmcr_el0(read_pmcr_el0() | PMCR_EL0_LC_BIT | PMCR_EL0_E_BIT);
+    isb();
+}
+
+/**
+ *   @brief    Reads the PMU cycle counter without changing the PMU state
+ *   @param    void
+ *   @return   Current cycle count, 0 without PMUv3 or when a test stopped the counter
+**/
+static uint64_t val_host_cycle_counter_read(void)
+{
+    if (!val_host_has_pmu())
+        return 0;
+
+    if (!(read_pmcr_el0() & PMCR_EL0_E_BIT) || !(read_pmcntenset_el0() & PMCNTENSET_EL0_C_BIT))
+        return 0;
+
+    return read_pmccntr_el0();
+}
+
+/**
+ *   @brief    Converts system counter ticks to microseconds
+ *   @param    ticks        -   System counter ticks
+ *   @return   Microseconds
+**/
+static uint64_t val_host_ticks_to_us(uint64_t ticks)
+{
+    uint64_t freq = val_read_cntfrq_el0();
+
+    return freq ? (ticks * 1000000) / freq : 0;
+}
+
+/**
+ *   @brief    Returns true when the heap peak of a test crosses HEAP_WARN_PERCENT
+ *             of the heap of the context it ran in
+ *   @param    test_num     -  Test number
+ *   @return   true/false
+**/
+static bool val_host_heap_over_limit(uint32_t test_num)
+{
+    return (test_mem_stats[test_num].heap_peak * 100) >
+           (test_mem_stats[test_num].heap_size * HEAP_WARN_PERCENT);
+}
+
+/**
+ *   @brief    Prints the heap usage and granule churn of a test
+ *   @param    test_num     -  Test number
+ *   @return   void
+**/
+static void val_host_print_mem_stats(uint32_t test_num)
+{
+    val_host_mem_stats_ts *stats = &test_mem_stats[test_num];
+
+    LOG(ALWAYS, "Heap     : %d KB peak, %d KB allocated\n",
+        stats->heap_peak / 1024, stats->heap_alloc / 1024);
+    LOG(ALWAYS, "Granules : %d delegated, %d undelegated,",
+        stats->delegated[VAL_HOST_GRANULE_LIST_NS],
+        stats->undelegated[VAL_HOST_GRANULE_LIST_NS]);
+    LOG(ALWAYS, " RD %d/%d,", stats->delegated[VAL_HOST_GRANULE_LIST_RD],
+        stats->undelegated[VAL_HOST_GRANULE_LIST_RD]);
+    LOG(ALWAYS, " REC %d/%d,", stats->delegated[VAL_HOST_GRANULE_LIST_REC],
+        stats->undelegated[VAL_HOST_GRANULE_LIST_REC]);
+    LOG(ALWAYS, " RTT %d/%d,", stats->delegated[VAL_HOST_GRANULE_LIST_RTT],
+        stats->undelegated[VAL_HOST_GRANULE_LIST_RTT]);
+    LOG(ALWAYS, " DATA %d/%d,", stats->delegated[VAL_HOST_GRANULE_LIST_DATA],
+        stats->undelegated[VAL_HOST_GRANULE_LIST_DATA]);
+    LOG(ALWAYS, " AUX %d/%d\n", stats->delegated[VAL_HOST_GRANULE_LIST_RTT_AUX],
+        stats->undelegated[VAL_HOST_GRANULE_LIST_RTT_AUX]);
+
+    if (val_host_heap_over_limit(test_num))
+        LOG(WARN, "Heap peak above %d percent of the %d KB heap\n",
+            HEAP_WARN_PERCENT, stats->heap_size / 1024);
+}
+
 /**
  *   @brief    Parses input status for a given test and
  *               outputs appropriate information on the console
@@ -58,9 +324,17 @@ uint64_t val_host_get_secondary_cpu_entry(void)
 static uint32_t val_host_report_status(uint32_t test_num)
 {
     uint32_t status, status_code, state;
-    char      test_result_print[PRINT_LIMIT] = "Result";
+    char      test_result_print[PRINT_LIMIT] = "";
+
+    /* Tests running in parallel interleave their output, tag the result */
+    if (val_get_ctx_id() != VAL_SERIAL_CTX_ID)
+    {
+        val_strcat(test_result_print, (char *)test_list[test_num].test_name,
+            sizeof(test_result_print));
+        val_strcat(test_result_print, " : ", sizeof(test_result_print));
+    }
+    val_strcat(test_result_print, "Result", sizeof(test_result_print));
 
-    (void)test_num;
     status = val_get_status();
     state = (status >> TEST_STATE_SHIFT) & TEST_STATE_MASK;
     status_code = status & TEST_STATUS_CODE_MASK;
@@ -91,9 +365,15 @@ static uint32_t val_host_report_status(uint32_t test_num)
             break;
     }
 
-    LOG(ALWAYS, test_result_print, status_code, 0);
+    LOG_VAR(ALWAYS, test_result_print, status_code, 0);
+    LOG(ALWAYS, "Duration : %d us, %d cycles\n",
+        val_host_ticks_to_us(test_timing[test_num].ticks), test_timing[test_num].cycles);
+    val_host_print_mem_stats(test_num);
     LOG(ALWAYS, "\n", 0, 0);
     LOG(ALWAYS, "***********************************\n", 0, 0);
+
+    /* Keep the console in step with test progress should the next test hang */
+    val_printf_flush();
     return state;
 }
 
@@ -106,14 +386,15 @@ static uint32_t val_host_report_status(uint32_t test_num)
 **/
 void val_host_set_reboot_flag(void)
 {
-   uint32_t test_progress  = TEST_REBOOTING;
-
    LOG(INFO, "\tSetting reboot flag\n", 0, 0);
-   if (val_nvm_write(VAL_NVM_OFFSET(NVM_TEST_PROGRESS_INDEX),
-                 &test_progress, sizeof(uint32_t)))
+   regre_state.test_progress = TEST_REBOOTING;
+   if (val_host_regre_journal_commit())
    {
       VAL_PANIC("\tnvm write failed\n");
    }
+
+   /* Test may reset through the watchdog, output must be out before that */
+   val_printf_flush();
 }
 
 /**
@@ -125,19 +406,16 @@ uint32_t val_host_get_last_run_test_info(val_test_info_ts *test_info)
 {
     uint32_t        reboot_run = 0, i = 0;
     uint8_t         test_progress_pattern[] = {TEST_START, TEST_END, TEST_FAIL, TEST_REBOOTING};
-    val_regre_report_ts  regre_report = {0};
-
-    if (val_nvm_read(VAL_NVM_OFFSET(NVM_CUR_TEST_NUM_INDEX),
-            &test_info->test_num, sizeof(uint32_t)))
-        return VAL_ERROR;
 
-    if (val_nvm_read(VAL_NVM_OFFSET(NVM_END_TEST_NUM_INDEX),
-            &test_info->end_test_num, sizeof(uint32_t)))
-        return VAL_ERROR;
-
-    if (val_nvm_read(VAL_NVM_OFFSET(NVM_TEST_PROGRESS_INDEX),
-            &test_info->test_progress, sizeof(uint32_t)))
-        return VAL_ERROR;
+    /* Recover from the last valid record, a torn or missing one reads as cold boot */
+    if (val_host_regre_journal_load() == VAL_SUCCESS)
+    {
+        test_info->test_num      = regre_state.test_num;
+        test_info->end_test_num  = regre_state.end_test_num;
+        test_info->test_progress = regre_state.test_progress;
+    } else {
+        test_info->test_progress = 0;
+    }
 
     LOG(INFO, "\tIn val_host_get_last_run_test_info, test_num=%x\n", test_info->test_num, 0);
     LOG(INFO, "\ttest_progress=%x\n", test_info->test_progress, 0);
@@ -162,34 +440,21 @@ uint32_t val_host_get_last_run_test_info(val_test_info_ts *test_info)
          test_info->end_test_num     = total_tests;
          test_info->test_progress     = 0;
 
-         if (val_nvm_write(VAL_NVM_OFFSET(NVM_CUR_TEST_NUM_INDEX),
-                 &test_info->test_num, sizeof(uint32_t)))
-             return VAL_ERROR;
-         if (val_nvm_write(VAL_NVM_OFFSET(NVM_END_TEST_NUM_INDEX),
-                 &test_info->end_test_num, sizeof(uint32_t)))
-             return VAL_ERROR;
-         if (val_nvm_write(VAL_NVM_OFFSET(NVM_TEST_PROGRESS_INDEX),
-                 &test_info->test_progress, sizeof(uint32_t)))
-             return VAL_ERROR;
-         if (val_nvm_write(VAL_NVM_OFFSET(NVM_TOTAL_PASS_INDEX),
-                 &regre_report.total_pass, sizeof(uint32_t)))
-             return VAL_ERROR;
-         if (val_nvm_write(VAL_NVM_OFFSET(NVM_TOTAL_FAIL_INDEX),
-                 &regre_report.total_fail, sizeof(uint32_t)))
-             return VAL_ERROR;
-         if (val_nvm_write(VAL_NVM_OFFSET(NVM_TOTAL_SKIP_INDEX),
-                 &regre_report.total_skip, sizeof(uint32_t)))
-             return VAL_ERROR;
-         if (val_nvm_write(VAL_NVM_OFFSET(NVM_TOTAL_ERROR_INDEX),
-                 &regre_report.total_error, sizeof(uint32_t)))
+         /* Sequence is kept so that the new record supersedes any stale one */
+         regre_state.test_num        = test_info->test_num;
+         regre_state.end_test_num    = test_info->end_test_num;
+         regre_state.test_progress   = test_info->test_progress;
+         val_memset(&regre_state.regre_report, 0, sizeof(regre_state.regre_report));
+
+         if (val_host_regre_journal_commit())
              return VAL_ERROR;
     }
 
     LOG(INFO, "\tIn val_host_get_last_run_test_num, test_num=%x\n", test_info->test_num, 0);
-    LOG(INFO, "\tregre_report.total_pass=%x\n", regre_report.total_pass, 0);
-    LOG(INFO, "\tregre_report.total_fail=%x\n", regre_report.total_fail, 0);
-    LOG(INFO, "\tregre_report.total_skip=%x\n", regre_report.total_skip, 0);
-    LOG(INFO, "\tregre_report.total_error=%x\n", regre_report.total_error, 0);
+    LOG(INFO, "\tregre_report.total_pass=%x\n", regre_state.regre_report.total_pass, 0);
+    LOG(INFO, "\tregre_report.total_fail=%x\n", regre_state.regre_report.total_fail, 0);
+    LOG(INFO, "\tregre_report.total_skip=%x\n", regre_state.regre_report.total_skip, 0);
+    LOG(INFO, "\tregre_report.total_error=%x\n", regre_state.regre_report.total_error, 0);
     return VAL_SUCCESS;
 }
 
@@ -203,7 +468,6 @@ uint32_t val_host_get_last_run_test_info(val_test_info_ts *test_info)
 static void val_host_test_init(uint32_t test_num)
 {
    char testname[PRINT_LIMIT] = "";
-   uint32_t test_progress = TEST_START;
 
    /* Clear test status */
    val_set_status(RESULT_START(VAL_STATUS_INVALID));
@@ -222,34 +486,50 @@ static void val_host_test_init(uint32_t test_num)
    val_strcat(testname, "\n", sizeof(testname));
 
    LOG(ALWAYS, "\n", 0, 0);
-   LOG(ALWAYS, testname, 0, 0);
+   LOG_VAR(ALWAYS, testname, 0, 0);
 
-   if (val_nvm_write(VAL_NVM_OFFSET(NVM_TEST_PROGRESS_INDEX),
-           &test_progress, sizeof(uint32_t)))
+   /* Test progress and watchdog are owned by the serial context */
+   if (val_get_ctx_id() == VAL_SERIAL_CTX_ID)
    {
-      VAL_PANIC("\tnvm write failed\n");
+      regre_state.test_num = test_num;
+      regre_state.test_progress = TEST_START;
+      if (val_host_regre_journal_commit())
+      {
+         VAL_PANIC("\tnvm write failed\n");
+      }
+
+      if (val_watchdog_enable())
+      {
+         VAL_PANIC("\tWatchdog enable failed\n");
+      }
    }
 
-   if (val_watchdog_enable())
-   {
-      VAL_PANIC("\tWatchdog enable failed\n");
-   }
+   /* Realm log ring starts empty for every test */
+   val_memset((void *)(val_get_shared_region_base() + LOG_RING_OFFSET), 0,
+              sizeof(val_log_ring_ts));
+
+   /* Reset mem alloc data structure, pool recovery reads the previous test's mem_track */
+   val_host_mem_alloc_init();
 
    /* Reset mem_track structure incase postamble is skipped */
    val_host_reset_mem_tack();
 
-   /* Reset mem alloc data structure */
-   val_host_mem_alloc_init();
+   /* Start values, turned into elapsed time by val_host_test_exit */
+   test_timing[test_num].cycles = val_host_cycle_counter_read();
+   test_timing[test_num].ticks = val_read_cntpct_el0();
 }
 
 /**
  * @brief  This API prints the final test result
- * @param  void
+ * @param  test_num     -   Test number
  * @return void
 **/
-static void val_host_test_exit(void)
+static void val_host_test_exit(uint32_t test_num)
 {
-   uint32_t test_progress = TEST_END;
+   uint64_t cycles;
+
+   /* Realm output still queued at test end */
+   val_host_realm_log_drain();
 
 #if defined(TEST_COMBINE)
    if (val_host_postamble())
@@ -259,19 +539,386 @@ static void val_host_test_exit(void)
    }
 #endif
 
-   if (val_watchdog_disable())
+   /* Test time includes the postamble teardown */
+   cycles = val_host_cycle_counter_read();
+   test_timing[test_num].ticks = val_read_cntpct_el0() - test_timing[test_num].ticks;
+   /* A test that stops or resets the PMU leaves no meaningful cycle count */
+   test_timing[test_num].cycles = (test_timing[test_num].cycles &&
+                                   cycles >= test_timing[test_num].cycles) ?
+                                  (cycles - test_timing[test_num].cycles) : 0;
+
+   /* Heap and granule usage, counted from the test start like the timing */
+   test_mem_stats[test_num] = val_host_get_mem_track_ctx()->stats;
+   val_host_heap_usage(&test_mem_stats[test_num].heap_peak,
+                       &test_mem_stats[test_num].heap_alloc,
+                       &test_mem_stats[test_num].heap_size);
+
+   /* Top up the delegated granule pool outside the timed section */
+   val_host_granule_pool_refill();
+
+   if (val_get_ctx_id() != VAL_SERIAL_CTX_ID)
+      return;
+
+   /* Work still queued would run into the next test */
+   if (!val_host_parked_cpus_idle())
    {
-      VAL_PANIC("\tWatchdog disable failed\n");
+      VAL_PANIC("\tTest left work queued on a parked cpu\n");
    }
 
-   if (val_nvm_write(VAL_NVM_OFFSET(NVM_TEST_PROGRESS_INDEX),
-           &test_progress, sizeof(uint32_t)))
+   if (val_watchdog_disable())
    {
-      VAL_PANIC("\tnvm write failed\n");
+      VAL_PANIC("\tWatchdog disable failed\n");
    }
 
+   /* Committed together with the test result by the dispatcher */
+   regre_state.test_progress = TEST_END;
+}
+
+/**
+ * @brief  Runs the host function of given test between test init and exit
+ * @param  test_num     -   Test number
+ * @return void
+**/
+static void val_host_test_run(uint32_t test_num)
+{
+    test_fptr_t fn_ptr = (test_fptr_t)(test_list[test_num].host_fn);
+
+    val_host_test_init(test_num);
+
+    *(uint64_t *)(val_get_shared_region_base() + PRINT_OFFSET) = 0xffffffffffffffff;
+    /* Execute host test */
+    skip_for_val_logs[val_get_ctx_id()] = 1;
+    fn_ptr();
+    skip_for_val_logs[val_get_ctx_id()] = 0;
+
+    val_host_test_exit(test_num);
+}
+
+/**
+ * @brief  Accounts the test result into given regression report
+ * @param  regre_report -   Regression report
+ * @param  test_result  -   Test state returned by val_host_report_status
+ * @return void
+**/
+static void val_host_update_regre_report(val_regre_report_ts *regre_report,
+                                         uint32_t test_result)
+{
+    switch (test_result)
+    {
+        case TEST_PASS:
+            regre_report->total_pass++;
+            break;
+        case TEST_FAIL:
+            regre_report->total_fail++;
+            break;
+        case TEST_SKIP:
+            regre_report->total_skip++;
+            break;
+        case TEST_ERROR:
+            regre_report->total_error++;
+            break;
+    }
+}
+
+#if defined(PARALLEL_DISPATCH)
+/**
+ * @brief  Returns true if the test must not run concurrently with other tests
+ * @param  test_num     -   Test number
+ * @return true/false
+**/
+static bool val_host_test_is_exclusive(uint32_t test_num)
+{
+    return (test_list[test_num].flags & TEST_FLAG_EXCLUSIVE) != 0;
+}
+
+/**
+ * @brief  Claims the next test of the parallel phase
+ * @param  void
+ * @return Test number or VAL_INVALID_TEST_NUM when no test is left
+**/
+static uint32_t val_host_parallel_claim_test(void)
+{
+    uint32_t test_num = VAL_INVALID_TEST_NUM;
+
+    val_spin_lock(&parallel.lock);
+    while (parallel.next_test <= parallel.end_test)
+    {
+        if (test_list[parallel.next_test].host_fn == NULL)
+        {
+            /* End of test list */
+            parallel.next_test = parallel.end_test + 1;
+            break;
+        }
+
+        if (!val_host_test_is_exclusive(parallel.next_test))
+        {
+            test_num = parallel.next_test++;
+            break;
+        }
+        parallel.next_test++;
+    }
+    val_spin_unlock(&parallel.lock);
+
+    return test_num;
+}
+
+/**
+ * @brief  Runs the tests of the parallel phase until none is left.
+ *         Called by the primary cpu and posted to every parked secondary cpu.
+ * @param  arg  -   Unused
+ * @return VAL_SUCCESS
+**/
+static uint64_t val_host_parallel_worker(uint64_t arg)
+{
+    uint32_t cpuid = val_get_cpuid(val_read_mpidr());
+    uint32_t test_num;
+
+    /* Switch to the cpu private slice of shared region, heap and VMIDs */
+    val_set_ctx_id(cpuid + 1);
+
+    while ((test_num = val_host_parallel_claim_test()) != VAL_INVALID_TEST_NUM)
+    {
+        val_host_test_run(test_num);
+        val_host_update_regre_report(&parallel.report[cpuid],
+                                     val_host_report_status(test_num));
+    }
+
+    val_set_ctx_id(VAL_SERIAL_CTX_ID);
+    (void)arg;
+    return VAL_SUCCESS;
+}
+
+/**
+ * @brief  Runs all non exclusive tests of given range concurrently on all cpus
+ *         and merges the per cpu results into the regression report
+ * @param  test_num_start   -   First test number
+ * @param  test_num_end     -   Last test number
+ * @param  regre_report     -   Regression report to update
+ * @return void
+**/
+static void val_host_parallel_dispatch(uint32_t test_num_start, uint32_t test_num_end,
+                                       val_regre_report_ts *regre_report)
+{
+    uint32_t i, cpuid = val_get_cpuid(val_read_mpidr());
+    uint32_t cpu_count = val_get_cpu_count();
+    bool cpu_on[PLATFORM_CPU_COUNT] = {0};
+
+    val_init_spinlock(&parallel.lock);
+    parallel.next_test = test_num_start;
+    parallel.end_test = test_num_end;
+    val_memset(parallel.report, 0, sizeof(parallel.report));
+    dsbsy();
+
+    LOG(ALWAYS, "\nParallel dispatch on %d cpus\n", cpu_count, 0);
+
+    for (i = 0; i < cpu_count; i++)
+    {
+        if (i == cpuid)
+            continue;
+
+        /* A cpu that fails to park simply takes no test */
+        if (val_host_park_cpu(i) == VAL_SUCCESS &&
+            val_host_post_work(i, val_host_parallel_worker, 0, &parallel.cpu_done[i]) == VAL_SUCCESS)
+            cpu_on[i] = true;
+    }
+
+    val_host_parallel_worker(0);
+
+    /* Secondaries stay parked, an exclusive test powering one on releases it */
+    for (i = 0; i < cpu_count; i++)
+    {
+        if (cpu_on[i])
+            (void)val_host_wait_future(&parallel.cpu_done[i]);
+    }
+
+    for (i = 0; i < cpu_count; i++)
+    {
+        regre_report->total_pass += parallel.report[i].total_pass;
+        regre_report->total_fail += parallel.report[i].total_fail;
+        regre_report->total_skip += parallel.report[i].total_skip;
+        regre_report->total_error += parallel.report[i].total_error;
+    }
+
+    LOG(ALWAYS, "\nParallel dispatch done, running exclusive tests\n", 0, 0);
+}
+#endif
+
+/**
+ *   @brief    Prints per test duration, per suite totals and the slowest tests
+ *   @param    void
+ *   @return   void
+**/
+static void val_host_print_timing_report(void)
+{
+    uint32_t i, j, n, slowest[VAL_SLOWEST_TEST_COUNT];
+    uint32_t suite_start = 1;
+    uint64_t suite_ticks = 0, suite_cycles = 0;
+
+    LOG(ALWAYS, "TIMING REPORT: \n", 0, 0);
+    LOG(ALWAYS, "==================\n", 0, 0);
+
+    for (i = 1; i < total_tests; i++)
+    {
+        /* Close the previous suite when the suite name changes */
+        if (i > suite_start && (test_list[i].host_fn == NULL ||
+            val_strcmp((char *)test_list[i].suite_name,
+                       (char *)test_list[suite_start].suite_name) != 0))
+        {
+            LOG_VAR(ALWAYS, (char *)test_list[suite_start].suite_name, 0, 0);
+            LOG(ALWAYS, "%d us, %d cycles\n", val_host_ticks_to_us(suite_ticks), suite_cycles);
+            suite_start = i;
+            suite_ticks = 0;
+            suite_cycles = 0;
+        }
+
+        if (test_list[i].host_fn == NULL)
+            break;
+
+        LOG_VAR(INFO, (char *)test_list[i].test_name, 0, 0);
+        LOG(INFO, " : %d us, %d cycles\n",
+            val_host_ticks_to_us(test_timing[i].ticks), test_timing[i].cycles);
+        suite_ticks += test_timing[i].ticks;
+        suite_cycles += test_timing[i].cycles;
+    }
+
+    /* Selection of the slowest tests, list is short and sorted descending */
+    for (n = 0; n < VAL_SLOWEST_TEST_COUNT; n++)
+    {
+        slowest[n] = 0;
+        for (i = 1; i < total_tests && test_list[i].host_fn != NULL; i++)
+        {
+            if (test_timing[i].ticks == 0 ||
+                (slowest[n] && test_timing[i].ticks <= test_timing[slowest[n]].ticks))
+                continue;
+
+            for (j = 0; j < n && slowest[j] != i; j++)
+                ;
+            if (j == n)
+                slowest[n] = i;
+        }
+
+        if (slowest[n] == 0)
+            break;
+    }
+
+    LOG(ALWAYS, "\n   SLOWEST TESTS   :\n", 0, 0);
+    for (i = 0; i < n; i++)
+    {
+        LOG(ALWAYS, "   ", 0, 0);
+        LOG_VAR(ALWAYS, (char *)test_list[slowest[i]].test_name, 0, 0);
+        LOG(ALWAYS, " : %d us, %d cycles\n",
+            val_host_ticks_to_us(test_timing[slowest[i]].ticks), test_timing[slowest[i]].cycles);
+    }
+    LOG(ALWAYS, "\n", 0, 0);
+}
+
+/**
+ *   @brief    Prints per suite heap peaks and granule churn, and the tests
+ *             with the largest heap peak
+ *   @param    void
+ *   @return   void
+**/
+static void val_host_print_mem_report(void)
+{
+    uint32_t i, j, n, largest[VAL_SLOWEST_TEST_COUNT];
+    uint32_t suite_start = 1, over_limit = 0;
+    uint64_t suite_peak = 0, suite_delegated = 0, suite_undelegated = 0;
+
+    LOG(ALWAYS, "MEMORY REPORT: \n", 0, 0);
+    LOG(ALWAYS, "==================\n", 0, 0);
+
+    for (i = 1; i < total_tests; i++)
+    {
+        /* Close the previous suite when the suite name changes */
+        if (i > suite_start && (test_list[i].host_fn == NULL ||
+            val_strcmp((char *)test_list[i].suite_name,
+                       (char *)test_list[suite_start].suite_name) != 0))
+        {
+            LOG_VAR(ALWAYS, (char *)test_list[suite_start].suite_name, 0, 0);
+            LOG(ALWAYS, "%d KB peak heap, ", suite_peak / 1024, 0);
+            LOG(ALWAYS, "%d granules delegated, %d undelegated\n",
+                suite_delegated, suite_undelegated);
+            suite_start = i;
+            suite_peak = 0;
+            suite_delegated = 0;
+            suite_undelegated = 0;
+        }
+
+        if (test_list[i].host_fn == NULL)
+            break;
+
+        if (test_mem_stats[i].heap_peak > suite_peak)
+            suite_peak = test_mem_stats[i].heap_peak;
+        suite_delegated += test_mem_stats[i].delegated[VAL_HOST_GRANULE_LIST_NS];
+        suite_undelegated += test_mem_stats[i].undelegated[VAL_HOST_GRANULE_LIST_NS];
+        if (val_host_heap_over_limit(i))
+            over_limit++;
+    }
+
+    /* Selection of the largest heap peaks, list is short and sorted descending */
+    for (n = 0; n < VAL_SLOWEST_TEST_COUNT; n++)
+    {
+        largest[n] = 0;
+        for (i = 1; i < total_tests && test_list[i].host_fn != NULL; i++)
+        {
+            if (test_mem_stats[i].heap_peak == 0 || (largest[n] &&
+                test_mem_stats[i].heap_peak <= test_mem_stats[largest[n]].heap_peak))
+                continue;
+
+            for (j = 0; j < n && largest[j] != i; j++)
+                ;
+            if (j == n)
+                largest[n] = i;
+        }
+
+        if (largest[n] == 0)
+            break;
+    }
+
+    LOG(ALWAYS, "\n   LARGEST HEAP PEAK :\n", 0, 0);
+    for (i = 0; i < n; i++)
+    {
+        LOG(ALWAYS, "   ", 0, 0);
+        LOG_VAR(ALWAYS, (char *)test_list[largest[i]].test_name, 0, 0);
+        LOG(ALWAYS, " : %d KB peak, %d KB allocated\n",
+            test_mem_stats[largest[i]].heap_peak / 1024,
+            test_mem_stats[largest[i]].heap_alloc / 1024);
+    }
+
+    if (over_limit)
+        LOG(WARN, "\n   %d tests above %d percent of their heap\n",
+            over_limit, HEAP_WARN_PERCENT);
+    LOG(ALWAYS, "\n", 0, 0);
 }
 
+#if defined(BOOT_BENCHMARK)
+/**
+ *   @brief    Prints the cycles per zeroed page of val_memset and val_zero_granule
+ *   @param    void
+ *   @return   void
+**/
+static void val_host_zero_benchmark(void)
+{
+    __attribute__((aligned (PAGE_SIZE))) static uint8_t zero_page[PAGE_SIZE];
+    uint64_t start, memset_cycles, zero_cycles;
+    uint32_t i;
+
+    start = val_host_cycle_counter_read();
+    for (i = 0; i < VAL_HOST_ZERO_BENCH_LOOPS; i++)
+        val_memset(zero_page, 0, PAGE_SIZE);
+    memset_cycles = (val_host_cycle_counter_read() - start) / VAL_HOST_ZERO_BENCH_LOOPS;
+
+    start = val_host_cycle_counter_read();
+    for (i = 0; i < VAL_HOST_ZERO_BENCH_LOOPS; i++)
+        val_zero_granule(zero_page);
+    zero_cycles = (val_host_cycle_counter_read() - start) / VAL_HOST_ZERO_BENCH_LOOPS;
+
+    LOG(ALWAYS, "\tZero page benchmark, DC ZVA block %d bytes\n", val_zva_block_size(), 0);
+    LOG(ALWAYS, "\t  val_memset       : %d cycles/page\n", memset_cycles, 0);
+    LOG(ALWAYS, "\t  val_zero_granule : %d cycles/page\n", zero_cycles, 0);
+}
+#endif
+
 /**
  *   @brief    Print ACS header
  *   @param    void
@@ -302,7 +949,10 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
     uint32_t          test_num_start = 0, test_num_end = 0;
     test_fptr_t       fn_ptr;
     val_test_info_ts       test_info = {0};
-    val_regre_report_ts    regre_report = {0};
+    val_regre_report_ts    *regre_report = &regre_state.regre_report;
+
+    /* The counter is per cpu and stops on reset, start it whenever a cpu boots */
+    val_host_cycle_counter_enable();
 
     if (primary_cpu_boot == true)
     {
@@ -317,6 +967,16 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
         {
            val_host_print_acs_header();
            test_info.test_num = 1;
+
+#if defined(BOOT_BENCHMARK)
+           if (val_nvm_benchmark())
+               LOG(WARN, "\tNVM benchmark failed\n", 0, 0);
+
+           if (val_libc_benchmark())
+               LOG(WARN, "\tlibc benchmark failed\n", 0, 0);
+
+           val_host_zero_benchmark();
+#endif
         } else
         {
            reboot_run = 1;
@@ -356,22 +1016,14 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
                 test_num_end = j;
             }
 
-            if ((val_nvm_write(VAL_NVM_OFFSET(NVM_END_TEST_NUM_INDEX),
-                                                    &test_num_end, sizeof(test_num_end))))
-            {
-                        LOG(ERROR, "\tUnable to write nvm\n", 0, 0);
-                        return;
-            }
+            /* Committed with the first test start record */
+            regre_state.end_test_num = test_num_end;
 #else
             test_num_start = test_info.test_num;
             test_num_end = total_tests;
 
-            if ((val_nvm_write(VAL_NVM_OFFSET(NVM_END_TEST_NUM_INDEX),
-                                                    &test_num_end, sizeof(test_num_end))))
-            {
-                        LOG(ERROR, "\tUnable to write nvm\n", 0, 0);
-                        return;
-            }
+            /* Committed with the first test start record */
+            regre_state.end_test_num = test_num_end;
 #endif
 
         }
@@ -380,6 +1032,19 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
             test_num_end = test_info.end_test_num;
         }
 
+#if defined(PARALLEL_DISPATCH)
+        if (!reboot_run)
+        {
+            val_host_parallel_dispatch(test_num_start, test_num_end, regre_report);
+
+            if (val_host_regre_journal_commit())
+            {
+                LOG(ERROR, "\tUnable to write regre_report\n", 0, 0);
+                return;
+            }
+        }
+#endif
+
         /* Iterate over test_list[] to run test one by one */
         for (i = test_num_start ; i <= test_num_end; i++)
         {
@@ -389,6 +1054,12 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
             if (fn_ptr == NULL)
                 break;
 
+#if defined(PARALLEL_DISPATCH)
+            /* Non exclusive tests already ran in the parallel phase */
+            if (!reboot_run && !val_host_test_is_exclusive(i))
+                continue;
+#endif
+
             if (reboot_run)
             {
                 /* Reboot case, find out whether reboot expected or not? */
@@ -403,64 +1074,16 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
                 }
                 reboot_run = 0;
             } else {
-                if ((val_nvm_write(VAL_NVM_OFFSET(NVM_CUR_TEST_NUM_INDEX),
-                                            &i, sizeof(i))))
-                {
-                    LOG(ERROR, "\tUnable to write nvm\n", 0, 0);
-                    return;
-                }
-
-                val_host_test_init(i);
-
-                *(uint64_t *)(val_get_shared_region_base() + PRINT_OFFSET) = 0xffffffffffffffff;
-	            /* Execute host test */
-                skip_for_val_logs = 1;
-                fn_ptr();
-                skip_for_val_logs = 0;
-
-	            val_host_test_exit();
+                val_host_test_run(i);
             }
 
             test_result = val_host_report_status(i);
 
-            if (val_nvm_read(VAL_NVM_OFFSET(NVM_TOTAL_PASS_INDEX),
-                     &regre_report.total_pass, sizeof(uint32_t)) ||
-                val_nvm_read(VAL_NVM_OFFSET(NVM_TOTAL_FAIL_INDEX),
-                     &regre_report.total_fail, sizeof(uint32_t))  ||
-                val_nvm_read(VAL_NVM_OFFSET(NVM_TOTAL_SKIP_INDEX),
-                     &regre_report.total_skip, sizeof(uint32_t))  ||
-                val_nvm_read(VAL_NVM_OFFSET(NVM_TOTAL_ERROR_INDEX),
-                     &regre_report.total_error, sizeof(uint32_t)))
+            val_host_update_regre_report(regre_report, test_result);
 
-            {
-                LOG(ERROR, "\tUnable to read regre_report\n", 0, 0);
-                return;
-            }
-
-            switch (test_result)
-            {
-                case TEST_PASS:
-                    regre_report.total_pass++;
-                    break;
-                case TEST_FAIL:
-                    regre_report.total_fail++;
-                    break;
-                case TEST_SKIP:
-                    regre_report.total_skip++;
-                    break;
-                case TEST_ERROR:
-                    regre_report.total_error++;
-                    break;
-            }
-
-            if (val_nvm_write(VAL_NVM_OFFSET(NVM_TOTAL_PASS_INDEX),
-                     &regre_report.total_pass, sizeof(uint32_t)) ||
-                val_nvm_write(VAL_NVM_OFFSET(NVM_TOTAL_FAIL_INDEX),
-                     &regre_report.total_fail, sizeof(uint32_t))  ||
-                val_nvm_write(VAL_NVM_OFFSET(NVM_TOTAL_SKIP_INDEX),
-                     &regre_report.total_skip, sizeof(uint32_t))  ||
-                val_nvm_write(VAL_NVM_OFFSET(NVM_TOTAL_ERROR_INDEX),
-                     &regre_report.total_error, sizeof(uint32_t)))
+            /* Single record commit carries the test end and updated totals */
+            regre_state.test_progress = TEST_END;
+            if (val_host_regre_journal_commit())
             {
                 LOG(ERROR, "\tUnable to write regre_report\n", 0, 0);
                 return;
@@ -472,17 +1095,28 @@ static void val_host_test_dispatch(bool primary_cpu_boot)
         LOG(ALWAYS, "REGRESSION REPORT: \n", 0, 0);
         LOG(ALWAYS, "==================\n", 0, 0);
         LOG(ALWAYS, "   TOTAL TESTS     : %d\n",
-            (uint64_t)(regre_report.total_pass
-            + regre_report.total_fail
-            + regre_report.total_skip
-            + regre_report.total_error),
+            (uint64_t)(regre_report->total_pass
+            + regre_report->total_fail
+            + regre_report->total_skip
+            + regre_report->total_error),
             0);
-        LOG(ALWAYS, "   TOTAL PASSED    : %d\n", regre_report.total_pass, 0);
-        LOG(ALWAYS, "   TOTAL FAILED    : %d\n", regre_report.total_fail, 0);
-        LOG(ALWAYS, "   TOTAL SKIPPED   : %d\n", regre_report.total_skip, 0);
-        LOG(ALWAYS, "   TOTAL SIM ERROR : %d\n\n", regre_report.total_error, 0);
+        LOG(ALWAYS, "   TOTAL PASSED    : %d\n", regre_report->total_pass, 0);
+        LOG(ALWAYS, "   TOTAL FAILED    : %d\n", regre_report->total_fail, 0);
+        LOG(ALWAYS, "   TOTAL SKIPPED   : %d\n", regre_report->total_skip, 0);
+        LOG(ALWAYS, "   TOTAL SIM ERROR : %d\n\n", regre_report->total_error, 0);
+        val_host_print_timing_report();
+        val_host_print_mem_report();
+#if defined(RMI_PROFILE)
+        val_host_rmi_profile_dump();
+#endif
+        /* Leave no pool granule in Realm PAS after the regression */
+        val_host_granule_pool_drain();
         LOG(ALWAYS, "******* END OF ACS *******\n", 0, 0);
     } else {
+        /* Secondary cpu woken up to run posted work */
+        if (val_host_is_cpu_parked(val_get_cpuid(val_read_mpidr())))
+            val_host_park_loop();
+
         /* Resume the current test for secondary cpu */
         fn_ptr = (test_fptr_t)(test_list[val_get_curr_test_num()].host_fn);
         if (fn_ptr == NULL)
@@ -527,6 +1161,7 @@ void val_host_main(bool primary_cpu_boot)
     val_host_test_dispatch(primary_cpu_boot);
 
     LOG(ALWAYS, "HOST : Entering standby.. \n", 0, 0);
+    val_printf_flush();
     pal_terminate_simulation();
 }
 
@@ -52,6 +52,11 @@ extern uintptr_t __BSS_START__, __BSS_END__;
                                 PLATFORM_MEMORY_POOL_SIZE,      \
                                 MT_RW_DATA | MT_NS,              \
                                 0x1000)
+/* Read only view of the realm image, for its header */
+#define REALM_IMAGE MAP_REGION_FLAT(                            \
+                                PLATFORM_REALM_IMAGE_BASE,      \
+                                PLATFORM_REALM_IMAGE_SIZE,      \
+                                MT_RO_DATA | MT_NS)
 #define NS_UART MAP_REGION_FLAT(                                \
                                 PLATFORM_NS_UART_BASE,          \
                                 PLATFORM_NS_UART_SIZE,          \
@@ -101,7 +106,8 @@ void val_host_add_mmap(void)
             HOST_RO,
             HOST_RW,
             HOST_BSS,
-            MEMORY_POOL
+            MEMORY_POOL,
+            REALM_IMAGE
     };
 
     mmap_add_ctx(&acs_host_xlat_ctx, host_regions);
@@ -9,6 +9,9 @@
 
 #define CONTEXT_ID_VALUE 0x5555
 
+/* Work queues of the parked secondary cpus, indexed by logical cpuid */
+static val_host_work_queue_ts work_queue[PLATFORM_CPU_COUNT];
+
 /**
  *   @brief    Power up the given core
  *   @param    target_cpuid     - Logical cpuid value of the core
@@ -19,6 +22,10 @@ uint64_t val_host_power_on_cpu(uint32_t target_cpuid)
     uint64_t target_cpu = val_get_mpidr(target_cpuid);
     uint64_t ret;
 
+    /* A parked cpu is already on, take it out of the park first */
+    if (val_host_release_cpu(target_cpuid))
+        return VAL_ERROR;
+
     ret = val_psci_cpu_on(target_cpu, val_host_get_secondary_cpu_entry(), CONTEXT_ID_VALUE);
     if (ret == PSCI_E_SUCCESS)
     {
@@ -41,3 +48,198 @@ uint64_t val_host_power_off_cpu(void)
     LOG(WARN, "\tPSCI_CPU_OFF failed, ret=0x%x\n", ret, 0);
     return VAL_ERROR;
 }
+
+/**
+ *   @brief    Check whether the given core is parked
+ *   @param    target_cpuid     - Logical cpuid value of the core
+ *   @return   true if the core waits for work in val_host_park_loop
+**/
+bool val_host_is_cpu_parked(uint32_t target_cpuid)
+{
+    return target_cpuid < PLATFORM_CPU_COUNT && work_queue[target_cpuid].parked;
+}
+
+/**
+ *   @brief    Check that no parked core has work queued or running
+ *   @param    void
+ *   @return   true if every parked core waits in val_host_park_loop
+**/
+bool val_host_parked_cpus_idle(void)
+{
+    uint32_t i;
+
+    for (i = 0; i < PLATFORM_CPU_COUNT; i++)
+    {
+        if (work_queue[i].parked && work_queue[i].head != work_queue[i].tail)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+ *   @brief    Power up the given core and park it waiting for work. The core
+ *             stays parked across tests until released.
+ *   @param    target_cpuid     - Logical cpuid value of the core
+ *   @return   SUCCESS/FAILURE
+**/
+uint64_t val_host_park_cpu(uint32_t target_cpuid)
+{
+    val_host_work_queue_ts *queue;
+    uint64_t ret;
+
+    if (target_cpuid >= PLATFORM_CPU_COUNT)
+        return VAL_ERROR;
+
+    queue = &work_queue[target_cpuid];
+    if (queue->parked)
+        return VAL_SUCCESS;
+
+    /* Seen by the secondary on boot, sends it to the park loop */
+    queue->head = 0;
+    queue->tail = 0;
+    queue->parked = 1;
+    dsbsy();
+
+    ret = val_psci_cpu_on(val_get_mpidr(target_cpuid), val_host_get_secondary_cpu_entry(),
+                          CONTEXT_ID_VALUE);
+    if (ret != PSCI_E_SUCCESS)
+    {
+        LOG(WARN, "\tPSCI_CPU_ON failed, ret=0x%x\n", ret, 0);
+        queue->parked = 0;
+        return VAL_ERROR;
+    }
+
+    return VAL_SUCCESS;
+}
+
+/**
+ *   @brief    Power down a parked core once its queued work is done. Does
+ *             nothing for a core that is not parked.
+ *   @param    target_cpuid     - Logical cpuid value of the core
+ *   @return   SUCCESS/FAILURE
+**/
+uint64_t val_host_release_cpu(uint32_t target_cpuid)
+{
+    if (!val_host_is_cpu_parked(target_cpuid))
+        return VAL_SUCCESS;
+
+    /* A NULL work item makes the park loop power the core off */
+    if (val_host_post_work(target_cpuid, NULL, 0, NULL))
+        return VAL_ERROR;
+
+    while (val_psci_affinity_info(val_get_mpidr(target_cpuid), 0) != PSCI_E_OFF)
+        ;
+
+    work_queue[target_cpuid].parked = 0;
+    return VAL_SUCCESS;
+}
+
+/**
+ *   @brief    Queue a function to run on a parked core. Waits while the
+ *             queue of the core is full.
+ *   @param    target_cpuid     - Logical cpuid value of the parked core
+ *   @param    fn               - Function to run, NULL powers the core off
+ *   @param    arg              - Argument passed to fn
+ *   @param    future           - Completion to fill in, may be NULL
+ *   @return   SUCCESS/FAILURE
+**/
+uint64_t val_host_post_work(uint32_t target_cpuid, val_host_work_fn_t fn, uint64_t arg,
+                            val_host_future_ts *future)
+{
+    val_host_work_queue_ts *queue;
+    val_host_work_ts *item;
+
+    if (!val_host_is_cpu_parked(target_cpuid))
+    {
+        LOG(ERROR, "\tcpu %d is not parked\n", target_cpuid, 0);
+        return VAL_ERROR;
+    }
+
+    queue = &work_queue[target_cpuid];
+    while (queue->tail - queue->head == VAL_HOST_WORK_QUEUE_DEPTH)
+    {
+        wfe();
+        dsbsy();
+    }
+
+    if (future)
+        future->done = 0;
+
+    item = &queue->item[queue->tail % VAL_HOST_WORK_QUEUE_DEPTH];
+    item->fn = fn;
+    item->arg = arg;
+    item->future = future;
+
+    /* The item is observed before the tail that publishes it */
+    dmbish();
+    queue->tail++;
+    dsbsy();
+    sev();
+
+    return VAL_SUCCESS;
+}
+
+/**
+ *   @brief    Wait for a posted work item to complete
+ *   @param    future           - Completion given to val_host_post_work
+ *   @return   Value returned by the work function
+**/
+uint64_t val_host_wait_future(val_host_future_ts *future)
+{
+    while (!future->done)
+    {
+        wfe();
+        dsbsy();
+    }
+
+    /* The result is read after the completion flag */
+    dmbish();
+    return future->ret;
+}
+
+/**
+ *   @brief    Run the work posted to the calling core until a NULL item asks
+ *             it to power off. Entered by a secondary woken by val_host_park_cpu.
+ *   @param    void
+ *   @return   void (Never returns)
+**/
+void val_host_park_loop(void)
+{
+    val_host_work_queue_ts *queue = &work_queue[val_get_cpuid(val_read_mpidr())];
+    val_host_work_ts item;
+
+    while (1)
+    {
+        while (queue->head == queue->tail)
+        {
+            wfe();
+            dsbsy();
+        }
+
+        /* The item is read after the tail that published it */
+        dmbish();
+        item = queue->item[queue->head % VAL_HOST_WORK_QUEUE_DEPTH];
+
+        if (item.fn == NULL)
+            break;
+
+        if (item.future)
+        {
+            item.future->ret = item.fn(item.arg);
+            dmbish();
+            item.future->done = 1;
+        } else {
+            item.fn(item.arg);
+        }
+
+        /* Frees the slot, and wakes a poster waiting on it or on the future */
+        dmbish();
+        queue->head++;
+        dsbsy();
+        sev();
+    }
+
+    queue->head++;
+    val_host_power_off_cpu();
+}
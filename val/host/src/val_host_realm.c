@@ -9,23 +9,13 @@
 #include "val_host_alloc.h"
 #include "val_host_helpers.h"
 
-int current_realm = 1;
-val_host_granule_ts *head = NULL;
-val_host_granule_ts *current = NULL;
-val_host_granule_ts *tail = NULL;
-
-val_host_memory_track_ts mem_track[VAL_HOST_MAX_REALMS] = {
-    {.rd = 0x00000000FFFFFFFF},
-    {.rd = 0x00000000FFFFFFFF},
-    {.rd = 0x00000000FFFFFFFF},
-    {.rd = 0x00000000FFFFFFFF},
-    {.rd = 0x00000000FFFFFFFF},
-    {.rd = 0x00000000FFFFFFFF},
-    {.rd = 0x00000000FFFFFFFF},
-    {.rd = 0x00000000FFFFFFFF},
-    {.rd = 0x00000000FFFFFFFF},
-    {.rd = 0x00000000FFFFFFFF}
-};
+/* Granule tracking state of each host execution context */
+static val_host_mem_track_ctx_ts mem_track_ctx[VAL_CTX_COUNT];
+
+/* Granule table and data hash, contexts own the slice matching their heap */
+static val_host_granule_ts granule_table[VAL_HOST_GRANULE_COUNT];
+static uint16_t granule_hash[VAL_HOST_GRANULE_HASH_SIZE];
+static val_host_unprot_map_ts unprot_arena[VAL_HOST_UNPROT_NODES];
 
 uint64_t aux_ipa_base[VAL_MAX_AUX_PLANES] = {
     VAL_PLANE1_IMAGE_BASE_IPA,
@@ -33,6 +23,16 @@ uint64_t aux_ipa_base[VAL_MAX_AUX_PLANES] = {
     VAL_RESERVED
 };
 
+/**
+ *   @brief    Returns the granule tracking state of the calling cpu context
+ *   @param    void
+ *   @return   Pointer to mem track context
+**/
+val_host_mem_track_ctx_ts *val_host_get_mem_track_ctx(void)
+{
+    return &mem_track_ctx[val_get_ctx_id()];
+}
+
 uint64_t val_host_rtt_level_mapsize(uint64_t rtt_level)
 {
     if (rtt_level > VAL_RTT_MAX_LEVEL)
@@ -63,23 +63,32 @@ uint32_t val_host_create_rtt_levels(val_host_realm_ts *realm,
 
     for (; rtt_level++ < rtt_max_level;)
     {
-        rtt = (uint64_t)val_host_mem_alloc(rtt_alignment, PAGE_SIZE);
-        if (!rtt)
+        if (rtt_alignment <= PAGE_SIZE)
         {
-            LOG(ERROR, "\tFailed to allocate memory for rtt\n", 0, 0);
-            return VAL_ERROR;
-        } else if (val_host_rmi_granule_delegate(rtt))
-        {
-            LOG(ERROR, "\tRtt delegation failed, rtt=0x%x\n", rtt, 0);
-            return VAL_ERROR;
+            rtt = val_host_granule_get();
+            if (!rtt)
+            {
+                LOG(ERROR, "\tFailed to get a delegated granule for rtt\n", 0, 0);
+                return VAL_ERROR;
+            }
+        } else {
+            rtt = (uint64_t)val_host_mem_alloc(rtt_alignment, PAGE_SIZE);
+            if (!rtt)
+            {
+                LOG(ERROR, "\tFailed to allocate memory for rtt\n", 0, 0);
+                return VAL_ERROR;
+            } else if (val_host_rmi_granule_delegate(rtt))
+            {
+                LOG(ERROR, "\tRtt delegation failed, rtt=0x%x\n", rtt, 0);
+                return VAL_ERROR;
+            }
         }
 
         rtt_ipa = ADDR_ALIGN_DOWN(ipa, val_host_rtt_level_mapsize(rtt_level - 1));
         if (val_host_rmi_rtt_create(realm->rd, rtt, rtt_ipa, rtt_level))
         {
             LOG(ERROR, "\tRtt create failed, rtt=0x%x\n", rtt, 0);
-            val_host_rmi_granule_undelegate(rtt);
-            val_host_mem_free((void *)rtt);
+            val_host_granule_put(rtt);
             return VAL_ERROR;
         }
     }
@@ -111,15 +120,25 @@ uint32_t val_host_create_aux_rtt_levels(val_host_realm_ts *realm,
 
     for (; rtt_level++ < rtt_max_level;)
     {
-        rtt = (uint64_t)val_host_mem_alloc(rtt_alignment, PAGE_SIZE);
-        if (!rtt)
+        if (rtt_alignment <= PAGE_SIZE)
         {
-            LOG(ERROR, "\tFailed to allocate memory for aux rtt\n", 0, 0);
-            return VAL_ERROR;
-        } else if (val_host_rmi_granule_delegate(rtt))
-        {
-            LOG(ERROR, "\tAUX RTT delegation failed, rtt=0x%x\n", rtt, 0);
-            return VAL_ERROR;
+            rtt = val_host_granule_get();
+            if (!rtt)
+            {
+                LOG(ERROR, "\tFailed to get a delegated granule for aux rtt\n", 0, 0);
+                return VAL_ERROR;
+            }
+        } else {
+            rtt = (uint64_t)val_host_mem_alloc(rtt_alignment, PAGE_SIZE);
+            if (!rtt)
+            {
+                LOG(ERROR, "\tFailed to allocate memory for aux rtt\n", 0, 0);
+                return VAL_ERROR;
+            } else if (val_host_rmi_granule_delegate(rtt))
+            {
+                LOG(ERROR, "\tAUX RTT delegation failed, rtt=0x%x\n", rtt, 0);
+                return VAL_ERROR;
+            }
         }
 
         rtt_ipa = ADDR_ALIGN_DOWN(ipa, val_host_rtt_level_mapsize(rtt_level - 1));
@@ -127,8 +146,7 @@ uint32_t val_host_create_aux_rtt_levels(val_host_realm_ts *realm,
         if (cmd_ret.x0)
         {
             LOG(ERROR, "\tRtt create failed, rtt=0x%x\n", rtt, 0);
-            val_host_rmi_granule_undelegate(rtt);
-            val_host_mem_free((void *)rtt);
+            val_host_granule_put(rtt);
             return VAL_ERROR;
         }
     }
@@ -186,11 +204,11 @@ uint32_t val_host_map_protected_data(val_host_realm_ts *realm,
         if (RMI_STATUS(ret) == RMI_ERROR_RTT)
         {
             rtt_level = RMI_INDEX(ret);
-            ret = val_host_rmi_rtt_read_entry(realm->rd,
+            ret = val_host_shadow_rtt_read_entry(realm->rd,
                         val_host_addr_align_to_level(ipa, rtt_level), rtt_level, &rtte);
             if (ret)
             {
-                LOG(ERROR, "\tval_host_rmi_rtt_read_entry, ret=0x%x\n", ret, 0);
+                LOG(ERROR, "\tval_host_shadow_rtt_read_entry, ret=0x%x\n", ret, 0);
                 return VAL_ERROR;
             }
 
@@ -290,11 +308,11 @@ uint32_t val_host_map_protected_data_unknown(val_host_realm_ts *realm,
         if (RMI_STATUS(ret) == RMI_ERROR_RTT)
         {
             rtt_level = RMI_INDEX(ret);
-            ret = val_host_rmi_rtt_read_entry(realm->rd,
+            ret = val_host_shadow_rtt_read_entry(realm->rd,
                             val_host_addr_align_to_level(ipa, rtt_level), rtt_level, &rtte);
             if (ret)
             {
-                LOG(ERROR, "\tval_host_rmi_rtt_read_entry, ret=0x%x\n", ret, 0);
+                LOG(ERROR, "\tval_host_shadow_rtt_read_entry, ret=0x%x\n", ret, 0);
                 return VAL_ERROR;
             }
 
@@ -461,12 +479,12 @@ uint32_t val_host_map_unprotected(val_host_realm_ts *realm,
     if (RMI_STATUS(ret) == RMI_ERROR_RTT)
         {
             rtt_level = RMI_INDEX(ret);
-            ret = val_host_rmi_rtt_read_entry(realm->rd,
+            ret = val_host_shadow_rtt_read_entry(realm->rd,
                        val_host_addr_align_to_level(ipa, rtt_level), rtt_level, &rtte);
 
             if (ret)
             {
-                LOG(ERROR, "\tval_host_rmi_rtt_read_entry, ret=0x%x\n", ret, 0);
+                LOG(ERROR, "\tval_host_shadow_rtt_read_entry, ret=0x%x\n", ret, 0);
                 return VAL_ERROR;
             }
 
@@ -594,11 +612,11 @@ uint32_t val_host_map_unprotected_attr(val_host_realm_ts *realm,
     if (RMI_STATUS(ret) == RMI_ERROR_RTT)
         {
             rtt_level = RMI_INDEX(ret);
-            ret = val_host_rmi_rtt_read_entry(realm->rd,
+            ret = val_host_shadow_rtt_read_entry(realm->rd,
                         val_host_addr_align_to_level(ipa, rtt_level), rtt_level, &rtte);
             if (ret)
             {
-                LOG(ERROR, "\tval_host_rmi_rtt_read_entry, ret=0x%x\n", ret, 0);
+                LOG(ERROR, "\tval_host_shadow_rtt_read_entry, ret=0x%x\n", ret, 0);
                 return VAL_ERROR;
             }
 
@@ -708,19 +726,12 @@ uint32_t val_host_realm_create(val_host_realm_ts *realm)
         }
     }
 
-    /* Allocate and delegate RD */
-    realm->rd = (uint64_t)val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+    /* Get a delegated RD */
+    realm->rd = val_host_granule_get();
     if (!realm->rd)
     {
-        LOG(ERROR, "\tFailed to allocate memory for rd\n", 0, 0);
+        LOG(ERROR, "\tFailed to get a delegated granule for rd\n", 0, 0);
         goto free_par;
-    } else {
-        ret = val_host_rmi_granule_delegate(realm->rd);
-        if (ret)
-        {
-            LOG(ERROR, "\trd delegation failed, rd=0x%x, ret=0x%x\n", realm->rd, ret);
-            goto free_rd;
-        }
     }
 
     /* Allocate memory for params */
@@ -731,7 +742,7 @@ uint32_t val_host_realm_create(val_host_realm_ts *realm)
         LOG(ERROR, "\tFailed to allocate memory for params\n", 0, 0);
         goto undelegate_rtt;
     }
-    val_memset(params, 0, PAGE_SIZE_4K);
+    val_zero_granule(params);
 
     /* Populate params */
     params->flags = realm->flags;
@@ -806,13 +817,11 @@ free_rtt:
     }
 
 undelegate_rd:
-    ret = val_host_rmi_granule_undelegate(realm->rd);
+    ret = val_host_granule_put(realm->rd);
     if (ret)
     {
         LOG(WARN, "\trd undelegation failed, rd=0x%x, ret=0x%x\n", realm->rd, ret);
     }
-free_rd:
-    val_host_mem_free((void *)realm->rd);
 
 free_par:
     val_host_mem_free((void *)realm->image_pa_base);
@@ -844,11 +853,11 @@ int val_host_ripas_init(val_host_realm_ts *realm, uint64_t base,
 
         if (RMI_STATUS(ret) == RMI_ERROR_RTT && rtt_level1 < VAL_RTT_MAX_LEVEL)
         {
-            ret = val_host_rmi_rtt_read_entry(realm->rd,
+            ret = val_host_shadow_rtt_read_entry(realm->rd,
                         val_host_addr_align_to_level(base, rtt_level1), rtt_level1, &rtte);
             if (ret)
             {
-                LOG(ERROR, "\tval_host_rmi_rtt_read_entry, ret=0x%x\n", ret, 0);
+                LOG(ERROR, "\tval_host_shadow_rtt_read_entry, ret=0x%x\n", ret, 0);
                 return VAL_ERROR;
             }
 
@@ -874,18 +883,47 @@ int val_host_ripas_init(val_host_realm_ts *realm, uint64_t base,
 }
 
 /**
- *   @brief    Creates memory mappings for realm image
+ *   @brief    Reads the used extents of the realm image from its header
+ *   @param    load_size        - Size of the loaded contents
+ *   @param    image_size       - Size including bss and stacks
+ *   @return   Void, falls back to the full image size on an invalid header
+**/
+static void val_host_realm_image_extents(uint64_t *load_size, uint64_t *image_size)
+{
+    val_host_realm_image_hdr_ts *hdr = (val_host_realm_image_hdr_ts *)PLATFORM_REALM_IMAGE_BASE;
+
+    if (hdr->magic != VAL_REALM_IMAGE_MAGIC || hdr->version != VAL_REALM_IMAGE_HDR_VERSION ||
+        hdr->load_size > hdr->image_size || hdr->image_size > PLATFORM_REALM_IMAGE_SIZE ||
+        !ADDR_IS_ALIGNED(hdr->load_size, PAGE_SIZE) || !ADDR_IS_ALIGNED(hdr->image_size, PAGE_SIZE))
+    {
+        LOG(WARN, "\tInvalid realm image header, mapping full image\n", 0, 0);
+        *load_size = PLATFORM_REALM_IMAGE_SIZE;
+        *image_size = PLATFORM_REALM_IMAGE_SIZE;
+        return;
+    }
+
+    *load_size = hdr->load_size;
+    *image_size = hdr->image_size;
+}
+
+/**
+ *   @brief    Creates memory mappings for realm image. Loaded contents are
+ *             copied with DATA_CREATE, bss and stacks are created with unknown
+ *             contents and the unused tail of the image region is left unmapped.
  *   @param    realm            - Realm strucrure
  *   @return   SUCCESS/FAILURE
 **/
 static uint32_t val_host_image_map(val_host_realm_ts *realm, uint64_t ipa_base, uint64_t pa_base)
 {
     uint64_t src_pa = PLATFORM_REALM_IMAGE_BASE;
-    uint32_t i = 0, j = 0;
+    uint64_t load_size, image_size;
+    uint32_t i = 0, j = 0, ret;
+
+    val_host_realm_image_extents(&load_size, &image_size);
 
     if (val_host_ripas_init(realm,
             ipa_base,
-            ipa_base + realm->image_pa_size,
+            ipa_base + image_size,
             VAL_RTT_MAX_LEVEL, PAGE_SIZE))
     {
         LOG(ERROR, "\trealm_init_ipa_state failed, ipa=0x%x\n",
@@ -893,14 +931,22 @@ static uint32_t val_host_image_map(val_host_realm_ts *realm, uint64_t ipa_base,
         return VAL_ERROR;
     }
     /* MAP image regions */
-    while (i < (realm->image_pa_size/PAGE_SIZE))
-    {
-        if (val_host_map_protected_data(realm,
-                pa_base + i * PAGE_SIZE,
-                ipa_base + i * PAGE_SIZE,
-                PAGE_SIZE,
-                src_pa + i * PAGE_SIZE
-                ))
+    while (i < (image_size/PAGE_SIZE))
+    {
+        if (i < (load_size/PAGE_SIZE))
+            ret = val_host_map_protected_data(realm,
+                    pa_base + i * PAGE_SIZE,
+                    ipa_base + i * PAGE_SIZE,
+                    PAGE_SIZE,
+                    src_pa + i * PAGE_SIZE
+                    );
+        else
+            ret = val_host_map_protected_data_unknown(realm,
+                    pa_base + i * PAGE_SIZE,
+                    ipa_base + i * PAGE_SIZE,
+                    PAGE_SIZE);
+
+        if (ret)
         {
             LOG(ERROR, "\tval_realm_map_protected_data failed, par_base=0x%x\n",
                     pa_base, 0);
@@ -924,7 +970,7 @@ static uint32_t val_host_image_map(val_host_realm_ts *realm, uint64_t ipa_base,
         i++;
     }
     realm->granules[realm->granules_mapped_count].ipa = ipa_base;
-    realm->granules[realm->granules_mapped_count].size = realm->image_pa_size;
+    realm->granules[realm->granules_mapped_count].size = image_size;
     realm->granules[realm->granules_mapped_count].level = VAL_RTT_MAX_LEVEL;
     realm->granules[realm->granules_mapped_count].pa = pa_base;
     realm->granules_mapped_count++;
@@ -990,6 +1036,54 @@ uint32_t val_host_map_protected_data_to_realm(val_host_realm_ts *realm,
     return VAL_SUCCESS;
 }
 
+/**
+ *   @brief    Maps protected memory into the realm with level 2 block mappings.
+ *             Each 2MB block is populated page by page and folded with RTT_FOLD.
+ *   @param    realm            - Realm strucrure
+ *   @param    data_create      - Data creation structure, ipa, target_pa and size
+ *                                must be multiples of VAL_RTT_L2_BLOCK_SIZE
+ *   @return   SUCCESS/FAILURE
+**/
+uint32_t val_host_map_protected_block_to_realm(val_host_realm_ts *realm,
+                                             val_data_create_ts *data_create)
+{
+    uint64_t ipa, rtt, ret;
+
+    if (!data_create->size || !ADDR_IS_ALIGNED(data_create->ipa, VAL_RTT_L2_BLOCK_SIZE) ||
+        !ADDR_IS_ALIGNED(data_create->target_pa, VAL_RTT_L2_BLOCK_SIZE) ||
+        !ADDR_IS_ALIGNED(data_create->size, VAL_RTT_L2_BLOCK_SIZE))
+    {
+        LOG(ERROR, "\tBlock mapping not 2MB aligned, ipa=0x%x, pa=0x%x\n",
+                data_create->ipa, data_create->target_pa);
+        return VAL_ERROR;
+    }
+
+    if (val_host_map_protected_data_to_realm(realm, data_create))
+        return VAL_ERROR;
+
+    for (ipa = data_create->ipa; ipa < data_create->ipa + data_create->size;
+                                                ipa += VAL_RTT_L2_BLOCK_SIZE)
+    {
+        ret = val_host_rmi_rtt_fold(realm->rd, ipa, VAL_RTT_MAX_LEVEL, &rtt);
+        if (ret)
+        {
+            LOG(ERROR, "\tRTT fold failed, ipa=0x%x, ret=0x%x\n", ipa, ret);
+            return VAL_ERROR;
+        }
+
+        ret = val_host_granule_put(rtt);
+        if (ret)
+        {
+            LOG(ERROR, "\tFolded rtt release failed, rtt=0x%x, ret=0x%x\n", rtt, ret);
+            return VAL_ERROR;
+        }
+    }
+
+    /* Entry added by val_host_map_protected_data_to_realm */
+    realm->granules[realm->granules_mapped_count - 1].level = VAL_RTT_MAX_LEVEL - 1;
+    return VAL_SUCCESS;
+}
+
 /**
  *   @brief    Creates memory mappings for shared region
  *   @param    realm            - Realm strucrure
@@ -999,11 +1093,12 @@ static uint32_t val_host_map_shared_region(val_host_realm_ts *realm)
 {
     uint32_t i = 0, j = 0;
     uint64_t ns_shared_base_pa = (uint64_t)val_get_shared_region_base_pa();
+    uint64_t ns_shared_size = val_get_shared_region_size();
     uint64_t ns_shared_base_ipa =
                             (uint64_t)val_get_shared_region_base_ipa(realm->s2sz & 0xff);
 
     /* MAP SHARED_NS region */
-    while (i < PLATFORM_SHARED_REGION_SIZE/PAGE_SIZE)
+    while (i < ns_shared_size/PAGE_SIZE)
     {
         if (val_host_map_unprotected(realm,
                 ns_shared_base_pa + i * PAGE_SIZE,
@@ -1033,7 +1128,7 @@ static uint32_t val_host_map_shared_region(val_host_realm_ts *realm)
         i++;
     }
     realm->granules[realm->granules_mapped_count].ipa = ns_shared_base_ipa;
-    realm->granules[realm->granules_mapped_count].size = PLATFORM_SHARED_REGION_SIZE;
+    realm->granules[realm->granules_mapped_count].size = ns_shared_size;
     realm->granules[realm->granules_mapped_count].level = VAL_RTT_MAX_LEVEL;
     realm->granules[realm->granules_mapped_count].pa = ns_shared_base_pa;
     realm->granules_mapped_count++;
@@ -1125,7 +1220,7 @@ uint32_t val_host_rec_create(val_host_realm_ts *realm)
         LOG(ERROR, "\tFailed to allocate memory for rec_params\n", 0, 0);
         return VAL_ERROR;
     }
-    val_memset(rec_params, 0x0, PAGE_SIZE);
+    val_zero_granule(rec_params);
     val_memset(&rec_create_flags, 0, sizeof(rec_create_flags));
 
     /* Populate rec_params */
@@ -1156,38 +1251,23 @@ uint32_t val_host_rec_create(val_host_realm_ts *realm)
             LOG(ERROR, "\tFailed to allocate memory for run[%d]\n", i, 0);
             goto free_rec_params;
         }
-        val_memset((void *)realm->run[i], 0x0, PAGE_SIZE);
+        val_zero_granule((void *)realm->run[i]);
 
-        /* Allocate and delegate REC */
-        realm->rec[i] = (uint64_t)val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+        /* Get a delegated REC */
+        realm->rec[i] = val_host_granule_get();
         if (!realm->rec[i])
         {
-            LOG(ERROR, "\tFailed to allocate memory for REC\n", 0, 0);
+            LOG(ERROR, "\tFailed to get a delegated granule for REC\n", 0, 0);
             goto free_rec_params;
-        } else {
-            ret = val_host_rmi_granule_delegate(realm->rec[i]);
-            if (ret)
-            {
-                LOG(ERROR, "\trec delegation failed, rec=0x%x, ret=0x%x\n", realm->rec[i], ret);
-                goto free_rec_params;
-            }
         }
 
         for (j = 0; j < aux_count; j++)
         {
-            rec_params->aux[j] = (uint64_t)val_host_mem_alloc(PAGE_SIZE, PAGE_SIZE);
+            rec_params->aux[j] = val_host_granule_get();
             if (!rec_params->aux[j])
             {
-                LOG(ERROR, "\tFailed to allocate memory for aux rec\n", 0, 0);
+                LOG(ERROR, "\tFailed to get a delegated granule for aux rec\n", 0, 0);
                 goto free_rec_params;
-            } else {
-                ret = val_host_rmi_granule_delegate(rec_params->aux[j]);
-                if (ret)
-                {
-                    LOG(ERROR, "\trec delegation failed, rec=0x%x, ret=0x%x\n",
-                                         rec_params->aux[j], ret);
-                    goto free_rec_params;
-                }
             }
             realm->rec_aux_granules[j + (i * aux_count)] = rec_params->aux[j];
         }
@@ -1199,6 +1279,7 @@ uint32_t val_host_rec_create(val_host_realm_ts *realm)
             LOG(ERROR, "\tREC create failed, ret=0x%x\n", ret, 0);
             goto free_rec_params;
         }
+        val_host_granule_set_run(realm->rec[i], realm->run[i]);
     }
 
     /* Free rec_params */
@@ -1208,24 +1289,22 @@ uint32_t val_host_rec_create(val_host_realm_ts *realm)
 free_rec_params:
     while (i > 0)
     {
-        ret = val_host_rmi_granule_undelegate(realm->rec[i]);
+        ret = val_host_granule_put(realm->rec[i]);
         if (ret)
         {
             LOG(WARN, "\trec undelegation failed, rec=0x%x, ret=0x%x\n", realm->rec[i], ret);
         }
 
-        val_host_mem_free((void *)realm->rec[i]);
         val_host_mem_free((void *)realm->run[i]);
 
         for (j = 0; j < aux_count; j++)
         {
-            ret = val_host_rmi_granule_undelegate(realm->rec_aux_granules[j + (i * aux_count)]);
+            ret = val_host_granule_put(realm->rec_aux_granules[j + (i * aux_count)]);
             if (ret)
             {
                 LOG(WARN, "\tgranule undelegation failed, PA=0x%x, ret=0x%x\n",
                 realm->rec_aux_granules[j + (i * aux_count)], ret);
             }
-            val_host_mem_free((void *)realm->rec_aux_granules[j + (i * aux_count)]);
         }
         i--;
         if (i == 0)
@@ -1377,45 +1456,296 @@ uint32_t val_host_check_realm_exit_psci(val_host_rec_run_ts *run, uint32_t psci_
 }
 
 /**
- *   @brief    Add granule to the NS mem track[0]
- *   @param    state      - state of granule
- *   @param    PA         - Physical address of granule
- *   @param    node       - node pointer
+ *   @brief    Returns the granule table and hash slots of the calling cpu context
+ *   @param    base        - First granule table index of the context
+ *   @param    count       - Number of granule table entries of the context
+ *   @param    hash_base   - First data hash slot of the context
+ *   @param    hash_count  - Number of data hash slots of the context
  *   @return   void
 **/
-void val_host_add_granule(uint32_t state, uint64_t PA, val_host_granule_ts *node)
+static void val_host_granule_slice(uint32_t *base, uint32_t *count,
+                                   uint32_t *hash_base, uint32_t *hash_count)
 {
-    val_host_granule_ts *granule_list;
+    uint32_t ctx_id = val_get_ctx_id();
 
-    /* if node is null, create node and add to NS mem_track[0] list
-       else add node directly to the list */
-    if (node == NULL)
+    /* Same split as the heap, see val_host_mem_alloc_init */
+    if (ctx_id == VAL_SERIAL_CTX_ID)
     {
-        granule_list = (val_host_granule_ts *) mem_alloc(sizeof(val_host_granule_ts),
-                                                              sizeof(val_host_granule_ts));
-        granule_list->state = state;
-        granule_list->PA = PA;
-        granule_list->next = NULL;
-        granule_list->is_granule_sliced = 0;
-        granule_list->rtt_tree_idx = 0;
-        for (uint64_t i = 0; i < VAL_MAX_AUX_PLANES; i++)
-            granule_list->has_auxiliary[i] = 0;
-    } else
+        *base = 0;
+        *count = VAL_HOST_GRANULE_COUNT;
+        *hash_base = 0;
+        *hash_count = VAL_HOST_GRANULE_HASH_SIZE;
+    } else {
+        *count = (uint32_t)(VAL_HOST_HEAP_SLICE_SIZE / PAGE_SIZE);
+        *base = (ctx_id - 1) * *count;
+        *hash_count = VAL_HOST_GRANULE_HASH_SIZE / PLATFORM_CPU_COUNT;
+        *hash_base = (ctx_id - 1) * *hash_count;
+    }
+}
+
+/**
+ *   @brief    Returns the unprotected mapping arena slice of the calling cpu context
+ *   @param    base        - First arena index of the context
+ *   @param    count       - Number of arena nodes of the context
+ *   @return   void
+**/
+static void val_host_unprot_slice(uint32_t *base, uint32_t *count)
+{
+    uint32_t ctx_id = val_get_ctx_id();
+
+    if (ctx_id == VAL_SERIAL_CTX_ID)
     {
-        granule_list = node;
+        *base = 0;
+        *count = VAL_HOST_UNPROT_NODES;
+    } else {
+        *count = VAL_HOST_UNPROT_NODES / PLATFORM_CPU_COUNT;
+        *base = (ctx_id - 1) * *count;
     }
+}
+
+/**
+ *   @brief    Takes a node from the unprotected mapping arena
+ *   @param    void
+ *   @return   Arena index or VAL_HOST_GRANULE_NONE when the arena is exhausted
+**/
+static uint16_t val_host_unprot_alloc(void)
+{
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+    uint16_t node = track_ctx->unprot_free;
+
+    if (node != VAL_HOST_GRANULE_NONE)
+        track_ctx->unprot_free = unprot_arena[node].next;
+
+    return node;
+}
+
+/**
+ *   @brief    Returns a node to the unprotected mapping arena
+ *   @param    node       - Arena index
+ *   @return   void
+**/
+static void val_host_unprot_free(uint16_t node)
+{
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+
+    unprot_arena[node].next = track_ctx->unprot_free;
+    track_ctx->unprot_free = node;
+}
+
+/**
+ *   @brief    Returns the granule table index of a PA
+ *   @param    PA         - Physical address of granule
+ *   @return   Table index or VAL_HOST_GRANULE_NONE for an untracked PA
+**/
+static uint16_t val_host_granule_idx(uint64_t PA)
+{
+    uint32_t base, count, hash_base, hash_count;
+    uint64_t idx;
+
+    if (PA < PLATFORM_HEAP_REGION_BASE)
+        return VAL_HOST_GRANULE_NONE;
+
+    val_host_granule_slice(&base, &count, &hash_base, &hash_count);
+    idx = (PA - PLATFORM_HEAP_REGION_BASE) / PAGE_SIZE;
+    if (idx >= base && idx < base + count)
+        return (uint16_t)idx;
+
+    /* Granule pool of the context, above all heaps */
+    base = (uint32_t)((VAL_HOST_POOL_BASE(val_get_ctx_id()) - PLATFORM_HEAP_REGION_BASE) /
+                      PAGE_SIZE);
+    if (idx >= base && idx < base + VAL_HOST_POOL_GRANULES)
+        return (uint16_t)idx;
+
+    return VAL_HOST_GRANULE_NONE;
+}
+
+/**
+ *   @brief    Returns the PA of a granule table index
+ *   @param    idx        - Granule table index
+ *   @return   Physical address of granule
+**/
+static uint64_t val_host_granule_pa(uint16_t idx)
+{
+    return PLATFORM_HEAP_REGION_BASE + (uint64_t)idx * PAGE_SIZE;
+}
+
+/**
+ *   @brief    Inserts a granule at the head of a mem track list
+ *   @param    idx        - Granule table index
+ *   @param    realm      - mem track index owning the list
+ *   @param    list       - List of the mem track entry
+ *   @return   void
+**/
+static void val_host_granule_link(uint16_t idx, uint8_t realm, uint8_t list)
+{
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+    val_host_granule_ts *granule = &granule_table[idx];
+    uint16_t *head = &track_ctx->mem_track[realm].list[list];
+
+    granule->realm = realm;
+    granule->list = list;
+    granule->run = VAL_HOST_GRANULE_NONE;
+    granule->prev = VAL_HOST_GRANULE_NONE;
+    granule->next = *head;
+    if (*head != VAL_HOST_GRANULE_NONE)
+        granule_table[*head].prev = idx;
+    *head = idx;
+}
+
+/**
+ *   @brief    Removes a granule from its mem track list
+ *   @param    idx        - Granule table index
+ *   @return   void
+**/
+static void val_host_granule_unlink(uint16_t idx)
+{
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+    val_host_granule_ts *granule = &granule_table[idx];
+
+    if (granule->prev != VAL_HOST_GRANULE_NONE)
+        granule_table[granule->prev].next = granule->next;
+    else
+        track_ctx->mem_track[granule->realm].list[granule->list] = granule->next;
+
+    if (granule->next != VAL_HOST_GRANULE_NONE)
+        granule_table[granule->next].prev = granule->prev;
+
+    granule->list = VAL_HOST_GRANULE_LIST_NONE;
+    granule->next = VAL_HOST_GRANULE_NONE;
+    granule->prev = VAL_HOST_GRANULE_NONE;
+}
+
+/**
+ *   @brief    Returns the hash key of a granule, the IPA for data granules and
+ *             VAL_HOST_RTT_KEY for tables
+ *   @param    granule    - Data, RTT or auxiliary RTT granule
+ *   @return   Hash key
+**/
+static uint64_t val_host_granule_key(val_host_granule_ts *granule)
+{
+    if (granule->list == VAL_HOST_GRANULE_LIST_DATA)
+        return VAL_HOST_GRANULE_IPA(granule);
+
+    return VAL_HOST_RTT_KEY(VAL_HOST_GRANULE_IPA(granule),
+                            VAL_HOST_GRANULE_FIELD(granule, LEVEL),
+                            VAL_HOST_GRANULE_FIELD(granule, TREE));
+}
+
+/**
+ *   @brief    Returns the home slot of a granule key in the context hash
+ *   @param    realm      - mem track index of the realm
+ *   @param    key        - Hash key of the granule
+ *   @param    hash_count - Number of hash slots of the context
+ *   @return   Slot offset within the context hash
+**/
+static uint32_t val_host_hash_slot(uint8_t realm, uint64_t key, uint32_t hash_count)
+{
+    key = (key / PAGE_SIZE) ^ ((key & (PAGE_SIZE - 1)) << 44) ^ ((uint64_t)realm << 56);
 
-    if (head == NULL)
+    return (uint32_t)((key * 0x9E3779B97F4A7C15ULL) >> 32) % hash_count;
+}
+
+/**
+ *   @brief    Finds the hash slot of a realm data or table granule
+ *   @param    realm      - mem track index of the realm
+ *   @param    key        - IPA of a data granule, or VAL_HOST_RTT_KEY of a table
+ *   @return   Global hash slot or VAL_HOST_GRANULE_HASH_SIZE if not present
+**/
+static uint32_t val_host_hash_find(uint8_t realm, uint64_t key)
+{
+    uint32_t base, count, hash_base, hash_count, slot, n;
+    val_host_granule_ts *granule;
+
+    val_host_granule_slice(&base, &count, &hash_base, &hash_count);
+    slot = val_host_hash_slot(realm, key, hash_count);
+
+    for (n = 0; n < hash_count; n++)
     {
-        head = granule_list;
-        mem_track[0].gran_type.ns = head;
-        mem_track[0].gran_type.ns->next = NULL;
-        tail = granule_list;
-    } else
+        if (granule_hash[hash_base + slot] == VAL_HOST_GRANULE_NONE)
+            break;
+
+        granule = &granule_table[granule_hash[hash_base + slot]];
+        if (granule->realm == realm && val_host_granule_key(granule) == key)
+            return hash_base + slot;
+
+        slot = (slot + 1) % hash_count;
+    }
+
+    return VAL_HOST_GRANULE_HASH_SIZE;
+}
+
+/**
+ *   @brief    Adds a realm data or table granule to the context hash
+ *   @param    idx        - Granule table index, realm, list and IPA word already set
+ *   @return   void
+**/
+static void val_host_hash_add(uint16_t idx)
+{
+    uint32_t base, count, hash_base, hash_count, slot;
+    val_host_granule_ts *granule = &granule_table[idx];
+
+    val_host_granule_slice(&base, &count, &hash_base, &hash_count);
+    slot = val_host_hash_slot(granule->realm, val_host_granule_key(granule), hash_count);
+
+    /* Never full, the context has more slots than granules */
+    while (granule_hash[hash_base + slot] != VAL_HOST_GRANULE_NONE)
+        slot = (slot + 1) % hash_count;
+
+    granule_hash[hash_base + slot] = idx;
+}
+
+/**
+ *   @brief    Removes a hash slot, shifting back the entries probed past it
+ *   @param    hslot      - Global hash slot returned by val_host_hash_find
+ *   @return   void
+**/
+static void val_host_hash_remove(uint32_t hslot)
+{
+    uint32_t base, count, hash_base, hash_count, hole, slot, home;
+    val_host_granule_ts *granule;
+
+    val_host_granule_slice(&base, &count, &hash_base, &hash_count);
+    hole = hslot - hash_base;
+    slot = hole;
+
+    while (1)
     {
-        tail->next = granule_list;
-        tail = tail->next;
+        slot = (slot + 1) % hash_count;
+        if (granule_hash[hash_base + slot] == VAL_HOST_GRANULE_NONE)
+            break;
+
+        granule = &granule_table[granule_hash[hash_base + slot]];
+        home = val_host_hash_slot(granule->realm, val_host_granule_key(granule), hash_count);
+
+        /* Entry stays if its home lies cyclically in (hole, slot] */
+        if ((hole <= slot) ? (hole < home && home <= slot) : (hole < home || home <= slot))
+            continue;
+
+        granule_hash[hash_base + hole] = granule_hash[hash_base + slot];
+        hole = slot;
     }
+
+    granule_hash[hash_base + hole] = VAL_HOST_GRANULE_NONE;
+}
+
+/**
+ *   @brief    Add granule to the NS mem track[0]
+ *   @param    state      - state of granule
+ *   @param    PA         - Physical address of granule
+ *   @return   void
+**/
+void val_host_add_granule(uint32_t state, uint64_t PA)
+{
+    uint16_t idx = val_host_granule_idx(PA);
+
+    if (idx == VAL_HOST_GRANULE_NONE)
+        return;
+
+    if (granule_table[idx].list != VAL_HOST_GRANULE_LIST_NONE)
+        val_host_granule_unlink(idx);
+
+    granule_table[idx].ipa = (uint64_t)state << VAL_HOST_GRANULE_STATE_SHIFT;
+    val_host_granule_link(idx, 0, VAL_HOST_GRANULE_LIST_NS);
 }
 
 /**
@@ -1425,11 +1755,12 @@ void val_host_add_granule(uint32_t state, uint64_t PA, val_host_granule_ts *node
 **/
 int val_host_get_curr_realm(uint64_t rd)
 {
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
     int i;
 
     for (i = 1; i < VAL_HOST_MAX_REALMS; i++)
     {
-        if (mem_track[i].rd == rd)
+        if (track_ctx->mem_track[i].rd == rd)
         {
             return i;
         }
@@ -1449,192 +1780,89 @@ int val_host_get_curr_realm(uint64_t rd)
 void val_host_update_granule_state(uint64_t rd, uint32_t state, uint64_t PA,
                                    uint64_t ipa, uint64_t rtt_level, uint64_t rtt_tree_idx)
 {
-    val_host_granule_ts *granule_node = NULL;
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+    val_host_granule_ts *granule;
+    uint16_t idx, node;
+    uint8_t list;
     int i;
 
     /* Get the current realm index for given realm rd */
-    current_realm = val_host_get_curr_realm(rd);
-
-    /* find node from NS mem_track[0] */
-    granule_node = val_host_find_granule(PA);
-
-    /* if node is not found add to the VALID_NS list */
-    if (granule_node == NULL)
-    {
-        val_host_granule_ts *granule_list_delegated =
-                             (val_host_granule_ts *) mem_alloc(sizeof(val_host_granule_ts),
-                                                                    sizeof(val_host_granule_ts));
-        granule_list_delegated->rd = rd;
-        granule_list_delegated->state = state;
-        granule_list_delegated->PA = PA;
-        granule_list_delegated->ipa = ipa;
-        granule_list_delegated->level = rtt_level;
-        granule_list_delegated->rtt_tree_idx = rtt_tree_idx;
-        granule_list_delegated->next = NULL;
-        for (i = 0; i < VAL_MAX_AUX_PLANES; i++)
-            granule_list_delegated->has_auxiliary[i] = 0;
+    track_ctx->current_realm = val_host_get_curr_realm(rd);
 
-        if (state == GRANULE_UNPROTECTED)
+    /* Unprotected IPAs have no delegated granule, PA holds the IPA */
+    if (state == GRANULE_UNPROTECTED)
+    {
+        node = val_host_unprot_alloc();
+        if (node == VAL_HOST_GRANULE_NONE)
         {
-            current = mem_track[current_realm].gran_type.valid_ns;
-            if (current == NULL)
-            {
-                 mem_track[current_realm].gran_type.valid_ns = granule_list_delegated;
-            } else
-            {
-                while (current->next != NULL)
-                {
-                    current = current->next;
-                }
-                current->next = granule_list_delegated;
-            }
+            LOG(WARN, "\tUnprotected mapping arena full, ipa=0x%x not tracked\n", ipa, 0);
+            return;
         }
+
+        unprot_arena[node].ipa = ipa;
+        unprot_arena[node].level = (uint8_t)rtt_level;
+        unprot_arena[node].aux = 0;
+        unprot_arena[node].next = track_ctx->mem_track[track_ctx->current_realm].valid_ns;
+        track_ctx->mem_track[track_ctx->current_realm].valid_ns = node;
         return;
     }
 
-    /* Update state from NS mem_track or remove node and add to the respective state list */
-    current = head;
+    /* Only granules delegated through the tracker are moved */
+    granule = val_host_find_granule(PA);
+    if (granule == NULL)
+        return;
 
     switch (state)
     {
         case GRANULE_RD:
-            val_host_remove_granule(&mem_track[0].gran_type.ns, PA);
-            granule_node->rd = rd;
-            granule_node->state = state;
-            granule_node->ipa = ipa;
-            granule_node->level = rtt_level;
-            granule_node->next = NULL;
-
             /* Add realm rd to the mem_track */
             for (i = 1; i < VAL_HOST_MAX_REALMS; i++)
             {
-                if (mem_track[i].rd == PA)
+                if (track_ctx->mem_track[i].rd == PA)
                 {
                     LOG(ERROR, "\tRealm already exists\n", 0, 0);
                     break;
-                } else if (mem_track[i].rd == 0x00000000FFFFFFFF) {
-                    current_realm = i;
-                    mem_track[current_realm].rd = PA;
+                } else if (track_ctx->mem_track[i].rd == 0x00000000FFFFFFFF) {
+                    track_ctx->current_realm = i;
+                    track_ctx->mem_track[track_ctx->current_realm].rd = PA;
                     break;
                 }
             }
-
-            mem_track[current_realm].gran_type.rd = granule_node;
+            list = VAL_HOST_GRANULE_LIST_RD;
             break;
 
         case GRANULE_REC:
-            val_host_remove_granule(&mem_track[0].gran_type.ns, PA);
-            granule_node->rd = rd;
-            granule_node->state = state;
-            granule_node->ipa = ipa;
-            granule_node->level = rtt_level;
-            granule_node->next = NULL;
-            current = mem_track[current_realm].gran_type.rec;
-
-            if (current == NULL)
-            {
-                 mem_track[current_realm].gran_type.rec = granule_node;
-            } else {
-                while (current->next != NULL)
-                {
-                    current = current->next;
-                }
-                current->next = granule_node;
-            }
-
+            list = VAL_HOST_GRANULE_LIST_REC;
             break;
 
         case GRANULE_RTT:
-            val_host_remove_granule(&mem_track[0].gran_type.ns, PA);
-            granule_node->rd = rd;
-            granule_node->state = state;
-            granule_node->ipa = ipa;
-            granule_node->level = rtt_level;
-            granule_node->next = NULL;
-
-            current = mem_track[current_realm].gran_type.rtt;
-            if (current == NULL)
-            {
-                 mem_track[current_realm].gran_type.rtt = granule_node;
-            } else {
-                while (current->next != NULL)
-                {
-                    current = current->next;
-                }
-                current->next = granule_node;
-            }
-
+            list = VAL_HOST_GRANULE_LIST_RTT;
             break;
 
         case GRANULE_RTT_AUX:
-            val_host_remove_granule(&mem_track[0].gran_type.ns, PA);
-            granule_node->rd = rd;
-            granule_node->state = state;
-            granule_node->ipa = ipa;
-            granule_node->level = rtt_level;
-            granule_node->rtt_tree_idx = rtt_tree_idx;
-            granule_node->next = NULL;
-
-            current = mem_track[current_realm].gran_type.rtt_aux;
-            if (current == NULL)
-            {
-                 mem_track[current_realm].gran_type.rtt_aux = granule_node;
-            } else {
-                while (current->next != NULL)
-                {
-                    current = current->next;
-                }
-                current->next = granule_node;
-            }
-
+            list = VAL_HOST_GRANULE_LIST_RTT_AUX;
             break;
 
         case GRANULE_DATA:
-            val_host_remove_granule(&mem_track[0].gran_type.ns, PA);
-            granule_node->rd = rd;
-            granule_node->state = state;
-            granule_node->ipa = ipa;
-            granule_node->level = rtt_level;
-            granule_node->next = NULL;
-
-            current = mem_track[current_realm].gran_type.data;
-            if (current == NULL)
-            {
-                 mem_track[current_realm].gran_type.data = granule_node;
-            } else {
-                while (current->next != NULL)
-                {
-                    current = current->next;
-                }
-                current->next = granule_node;
-            }
-
-            break;
-
-        case GRANULE_UNPROTECTED:
-            val_host_remove_granule(&mem_track[0].gran_type.ns, PA);
-            granule_node->rd = rd;
-            granule_node->ipa = ipa;
-            granule_node->level = rtt_level;
-            granule_node->next = NULL;
-
-            current = mem_track[current_realm].gran_type.valid_ns;
-            if (current == NULL)
-            {
-                 mem_track[current_realm].gran_type.valid_ns = granule_node;
-            } else {
-                while (current->next != NULL)
-                {
-                    current = current->next;
-                }
-                current->next = granule_node;
-            }
-
+            list = VAL_HOST_GRANULE_LIST_DATA;
             break;
 
         default:
-            break;
+            return;
     }
+
+    idx = (uint16_t)(granule - granule_table);
+    val_host_granule_unlink(idx);
+    granule->ipa = (ipa & ~VAL_HOST_GRANULE_ATTR_MASK) |
+                   ((uint64_t)state << VAL_HOST_GRANULE_STATE_SHIFT) |
+                   ((rtt_level & VAL_HOST_GRANULE_LEVEL_MASK) << VAL_HOST_GRANULE_LEVEL_SHIFT) |
+                   ((rtt_tree_idx & VAL_HOST_GRANULE_TREE_MASK) << VAL_HOST_GRANULE_TREE_SHIFT);
+    val_host_granule_link(idx, (uint8_t)track_ctx->current_realm, list);
+    track_ctx->stats.delegated[list]++;
+
+    if (list == VAL_HOST_GRANULE_LIST_DATA || list == VAL_HOST_GRANULE_LIST_RTT ||
+        list == VAL_HOST_GRANULE_LIST_RTT_AUX)
+        val_host_hash_add(idx);
 }
 
 /**
@@ -1644,83 +1872,212 @@ void val_host_update_granule_state(uint64_t rd, uint32_t state, uint64_t PA,
 **/
 val_host_granule_ts *val_host_find_granule(uint64_t PA)
 {
-    val_host_granule_ts *find = head;
+    uint16_t idx = val_host_granule_idx(PA);
 
-    while (find != NULL)
-    {
-        if (find->PA == PA)
-            return find;
-        find = find->next;
-    }
+    if (idx == VAL_HOST_GRANULE_NONE ||
+        granule_table[idx].list != VAL_HOST_GRANULE_LIST_NS)
+        return NULL;
 
-    return NULL;
+    return &granule_table[idx];
 }
 
 /**
- *   @brief    Remove granule from given mem track list
- *   @param    gran_list_head      - head pointer of granule list
- *   @param    PA                  - Physical address of granule
- *   @return   Returns the removed granule from mem track list
+ *   @brief    Checks whether a granule is delegated or owned by a realm
+ *   @param    PA         - Physical address of granule
+ *   @return   Returns true if the granule is on any mem track list
 **/
-val_host_granule_ts *val_host_remove_granule(val_host_granule_ts **gran_list_head, uint64_t PA)
+bool val_host_is_granule_tracked(uint64_t PA)
 {
-    val_host_granule_ts *current = *gran_list_head, *prev = NULL, *temp = NULL;
+    uint16_t idx = val_host_granule_idx(PA);
 
-    temp = mem_track[0].gran_type.ns;
+    return (idx != VAL_HOST_GRANULE_NONE &&
+            granule_table[idx].list != VAL_HOST_GRANULE_LIST_NONE);
+}
 
-    if ((current != NULL) && (current->PA == PA))
+/**
+ *   @brief    Removes a delegated granule from the NS mem track list
+ *   @param    PA         - Physical address of granule
+ *   @return   void
+**/
+void val_host_untrack_granule(uint64_t PA)
+{
+    if (val_host_find_granule(PA) != NULL)
+        val_host_granule_unlink(val_host_granule_idx(PA));
+}
+
+/**
+ *   @brief    Records the run page of a tracked REC, val_host_realm_destroy
+ *             frees it together with the REC
+ *   @param    rec        - Physical address of the REC granule
+ *   @param    run        - Heap address of the run page
+ *   @return   void
+**/
+void val_host_granule_set_run(uint64_t rec, uint64_t run)
+{
+    uint16_t idx = val_host_granule_idx(rec);
+
+    if (idx != VAL_HOST_GRANULE_NONE && granule_table[idx].list == VAL_HOST_GRANULE_LIST_REC)
+        granule_table[idx].run = val_host_granule_idx(run);
+}
+
+/**
+ *   @brief    Records the RTT level mapping the data granules of a 2MB range,
+ *             called when the range is folded into a block or split again
+ *   @param    rd         - Realm RD
+ *   @param    ipa        - IPA within the range
+ *   @param    level      - VAL_RTT_MAX_LEVEL - 1 for a block, else VAL_RTT_MAX_LEVEL
+ *   @return   void
+**/
+void val_host_update_data_level(uint64_t rd, uint64_t ipa, uint64_t level)
+{
+    uint8_t realm = (uint8_t)val_host_get_curr_realm(rd);
+    uint64_t base = ADDR_ALIGN_DOWN(ipa, VAL_RTT_L2_BLOCK_SIZE), offset;
+    val_host_granule_ts *granule;
+    uint32_t hslot;
+
+    /* Data granules are created at level 0, keep that for page mappings */
+    level = (level == VAL_RTT_MAX_LEVEL - 1) ? level : 0;
+
+    /* A block is fully populated, an empty first granule means no data */
+    if (val_host_hash_find(realm, base) == VAL_HOST_GRANULE_HASH_SIZE)
+        return;
+
+    for (offset = 0; offset < VAL_RTT_L2_BLOCK_SIZE; offset += PAGE_SIZE)
     {
-        /* If its NS mem_track list update head */
-        if (temp == *gran_list_head)
-        {
-            head = current->next;
-            mem_track[0].gran_type.ns = head;
-            current->next = NULL;
-            return current;
-        } else {
-            prev = current;
-            current = current->next;
-            *gran_list_head = current;
-            prev->next = NULL;
-            return prev;
-        }
+        hslot = val_host_hash_find(realm, base + offset);
+        if (hslot == VAL_HOST_GRANULE_HASH_SIZE)
+            continue;
+
+        granule = &granule_table[granule_hash[hslot]];
+        granule->ipa = (granule->ipa &
+                        ~(VAL_HOST_GRANULE_LEVEL_MASK << VAL_HOST_GRANULE_LEVEL_SHIFT)) |
+                       (level << VAL_HOST_GRANULE_LEVEL_SHIFT);
     }
+}
+
+/**
+ *   @brief    Records the RTT starting level of a realm, which enables the
+ *             tracker lookups of val_host_shadow_rtt_read_entry
+ *   @param    rd         - Realm RD
+ *   @param    level      - rtt_level_start of the realm parameters
+ *   @return   void
+**/
+void val_host_update_rtt_start(uint64_t rd, uint64_t level)
+{
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+    int realm = val_host_get_curr_realm(rd);
+
+    /* LPA2 start level -1 is left to RMI */
+    if (realm && level <= VAL_RTT_MAX_LEVEL)
+        track_ctx->mem_track[realm].rtt_start = (uint8_t)level;
+}
 
-    while (NULL != current)
+/**
+ *   @brief    Returns the walk level and state of an RTT entry from the granule
+ *             tracker, without RMI_RTT_READ_ENTRY. desc holds the PA of a table
+ *             or data granule and is 0 for unprotected entries, ripas is not
+ *             mirrored and reads as RMI_EMPTY. Realms the tracker does not know
+ *             fall back to RMI.
+ *   @param    rd         - Realm RD
+ *   @param    ipa        - IPA, aligned down to the level by this function
+ *   @param    level      - RTT level to walk to
+ *   @param    rtte       - RTT entry
+ *   @return   RMI status of the lookup
+**/
+uint64_t val_host_shadow_rtt_read_entry(uint64_t rd, uint64_t ipa, uint64_t level,
+                                        val_host_rtt_entry_ts *rtte)
+{
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+    int realm = val_host_get_curr_realm(rd);
+    uint64_t walk, base;
+    uint32_t hslot;
+    uint16_t node;
+    val_host_granule_ts *granule;
+#if defined(SHADOW_RTT_CHECK)
+    val_host_rtt_entry_ts check;
+    uint64_t ret;
+#endif
+
+    if (!realm || track_ctx->mem_track[realm].rtt_start == VAL_HOST_RTT_START_NONE ||
+        level > VAL_RTT_MAX_LEVEL || level < track_ctx->mem_track[realm].rtt_start)
+        return val_host_rmi_rtt_read_entry(rd, val_host_addr_align_to_level(ipa, level),
+                                           level, rtte);
+
+    /* Descend while the entry at the walk level points to a tracked table */
+    for (walk = track_ctx->mem_track[realm].rtt_start; walk < level; walk++)
     {
-        if (current->PA != PA)
-        {
-            prev = current;
-            current = current->next;
-        } else {
+        base = ADDR_ALIGN_DOWN(ipa, val_host_rtt_level_mapsize(walk));
+        if (val_host_hash_find((uint8_t)realm, VAL_HOST_RTT_KEY(base, walk + 1, 0))
+                                                        == VAL_HOST_GRANULE_HASH_SIZE)
             break;
+    }
+
+    base = ADDR_ALIGN_DOWN(ipa, val_host_rtt_level_mapsize(walk));
+    rtte->walk_level = walk;
+    rtte->state = RMI_UNASSIGNED;
+    rtte->desc = 0;
+    rtte->ripas = RMI_EMPTY;
+
+    hslot = VAL_HOST_GRANULE_HASH_SIZE;
+    if (walk < VAL_RTT_MAX_LEVEL)
+        hslot = val_host_hash_find((uint8_t)realm, VAL_HOST_RTT_KEY(base, walk + 1, 0));
+
+    if (hslot != VAL_HOST_GRANULE_HASH_SIZE)
+    {
+        rtte->state = RMI_TABLE;
+        rtte->desc = val_host_granule_pa(granule_hash[hslot]);
+        goto exit;
+    }
+
+    /* Data is mapped by a page at level 3 or by a folded block at level 2 */
+    if (walk >= VAL_RTT_MAX_LEVEL - 1)
+        hslot = val_host_hash_find((uint8_t)realm, base);
+
+    if (hslot != VAL_HOST_GRANULE_HASH_SIZE)
+    {
+        granule = &granule_table[granule_hash[hslot]];
+        if (walk == VAL_RTT_MAX_LEVEL ||
+            VAL_HOST_GRANULE_FIELD(granule, LEVEL) == VAL_RTT_MAX_LEVEL - 1)
+        {
+            rtte->state = RMI_ASSIGNED;
+            rtte->desc = val_host_granule_pa(granule_hash[hslot]);
+            goto exit;
         }
     }
 
-    if (current == NULL)
-        return NULL;
-    else if (current->PA == PA)
+    for (node = track_ctx->mem_track[realm].valid_ns; node != VAL_HOST_GRANULE_NONE;
+                                                    node = unprot_arena[node].next)
     {
-        prev->next = current->next;
-        if (mem_track[0].gran_type.ns == *gran_list_head)
+        if (unprot_arena[node].ipa == base && unprot_arena[node].level == walk)
         {
-            if (current->next == NULL)
-                tail = prev;
+            rtte->state = RMI_ASSIGNED;
+            break;
         }
-        current->next = NULL;
-        return current;
-    } else {
-        return NULL;
     }
 
-    return NULL;
+exit:
+#if defined(SHADOW_RTT_CHECK)
+    ret = val_host_rmi_rtt_read_entry(rd, val_host_addr_align_to_level(ipa, level),
+                                      level, &check);
+    if (ret || check.walk_level != rtte->walk_level || check.state != rtte->state)
+    {
+        LOG(ERROR, "\tShadow RTT mismatch, ipa=0x%x level=%d\n", ipa, level);
+        LOG(ERROR, "\tshadow walk_level=%d state=%d\n", rtte->walk_level, rtte->state);
+        LOG(ERROR, "\tRMM walk_level=%d state=%d\n", check.walk_level, check.state);
+    }
 
+    /* The RMM answer stands, ripas included */
+    *rtte = check;
+    return ret;
+#else
+    return RMI_SUCCESS;
+#endif
 }
 
 /**
  *   @brief    Rollback mem_track state update
  *   @param    rd                - Realm RD
- *   @param    PA                - Physical address of granule
+ *   @param    PA                - Physical address of granule, IPA for unprotected
  *   @param    ipa               - IPA Address
  *   @param    level             - RTT level
  *   @param    state             - state of granule
@@ -1731,345 +2088,396 @@ void val_host_update_destroy_granule_state(uint64_t rd, uint64_t PA,
                                        uint64_t ipa, uint64_t level,
                            uint32_t state, uint32_t gran_list_state, uint64_t rtt_tree_idx)
 {
-    val_host_granule_ts *node = NULL;
-    int i;
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+    uint16_t idx, *node;
+    uint32_t hslot;
+
+    (void)level;
+    (void)rtt_tree_idx;
 
     if (state == GRANULE_UNDELEGATED)
     {
-        node = val_host_find_granule(PA);
-        if (node != NULL)
-        {
-            if (node->is_granule_sliced == 0)
-            {
-                node = val_host_remove_granule(&mem_track[0].gran_type.ns, PA);
-                val_host_mem_free((void *)node->PA);
-                val_host_mem_free(node);
-                return;
-            } else if (node->is_granule_sliced == 1) {
-                     node->state = state;
-            }
-        }
+        /* Granule is back in the NS PAS, the heap or the pool owns it again */
+        val_host_untrack_granule(PA);
+        val_host_granule_pool_undelegated(PA);
         return;
     }
 
     if (gran_list_state != GRANULE_REC)
     {
-        current_realm = val_host_get_curr_realm(rd);
+        track_ctx->current_realm = val_host_get_curr_realm(rd);
     }
 
     switch (gran_list_state)
     {
-        case GRANULE_RTT:
-            node = val_host_remove_rtt_granule(&mem_track[current_realm].gran_type.rtt, ipa, level);
-            node->state = state;
-            val_host_add_granule(state, node->PA, node);
-            break;
-
-        case GRANULE_RTT_AUX:
-            node = val_host_remove_aux_rtt_granule(&mem_track[current_realm].gran_type.rtt_aux,
-                                                                         ipa, level, rtt_tree_idx);
-            node->state = state;
-            val_host_add_granule(state, node->PA, node);
-            break;
-
         case GRANULE_DATA:
-            node = val_host_remove_data_granule(&mem_track[current_realm].gran_type.data, ipa);
-            node->state = state;
-            val_host_add_granule(state, node->PA, node);
+            hslot = val_host_hash_find((uint8_t)track_ctx->current_realm, ipa);
+            if (hslot == VAL_HOST_GRANULE_HASH_SIZE)
+                return;
+            idx = granule_hash[hslot];
+            val_host_hash_remove(hslot);
             break;
 
+        case GRANULE_RTT:
+        case GRANULE_RTT_AUX:
         case GRANULE_REC:
-            for (i = 1; i < VAL_HOST_MAX_REALMS; i++)
+        case GRANULE_RD:
+            idx = val_host_granule_idx(PA);
+            if (idx == VAL_HOST_GRANULE_NONE ||
+                granule_table[idx].list == VAL_HOST_GRANULE_LIST_NONE ||
+                granule_table[idx].list == VAL_HOST_GRANULE_LIST_NS)
+                return;
+            if (gran_list_state == GRANULE_RD)
             {
-                node = val_host_remove_granule(&mem_track[i].gran_type.rec, PA);
-                if (node != NULL)
-                {
-                    node->state = state;
-                    val_host_add_granule(state, PA, node);
-                    break;
-                }
+                track_ctx->mem_track[granule_table[idx].realm].rd = 0x00000000FFFFFFFF;
+                track_ctx->mem_track[granule_table[idx].realm].rtt_start = VAL_HOST_RTT_START_NONE;
             }
-            break;
 
-        case GRANULE_RD:
-            node = val_host_remove_granule(&mem_track[current_realm].gran_type.rd, PA);
-            node->state = state;
-            val_host_add_granule(state, PA, node);
-            mem_track[current_realm].rd = 0x00000000FFFFFFFF;
+            /* Tables leave the shadow RTT with their tracker entry */
+            if (granule_table[idx].list == VAL_HOST_GRANULE_LIST_RTT ||
+                granule_table[idx].list == VAL_HOST_GRANULE_LIST_RTT_AUX)
+            {
+                hslot = val_host_hash_find(granule_table[idx].realm,
+                                           val_host_granule_key(&granule_table[idx]));
+                if (hslot != VAL_HOST_GRANULE_HASH_SIZE)
+                    val_host_hash_remove(hslot);
+            }
             break;
 
         case GRANULE_UNPROTECTED:
-            node = val_host_remove_granule(&mem_track[current_realm].gran_type.valid_ns, PA);
-            node->state = GRANULE_UNDELEGATED;
-            val_host_add_granule(state, PA, node);
-            break;
+            node = &track_ctx->mem_track[track_ctx->current_realm].valid_ns;
+            while (*node != VAL_HOST_GRANULE_NONE && unprot_arena[*node].ipa != PA)
+                node = &unprot_arena[*node].next;
+
+            if (*node != VAL_HOST_GRANULE_NONE)
+            {
+                idx = *node;
+                *node = unprot_arena[idx].next;
+                val_host_unprot_free(idx);
+            }
+            return;
+
+        default:
+            return;
     }
+
+    track_ctx->stats.undelegated[granule_table[idx].list]++;
+    val_host_add_granule(state, val_host_granule_pa(idx));
 }
 
 /**
- *   @brief    Remove data granule from data list and add to the NS mem_track
- *   @param    gran_list_head      - Data granule which needs to remove from data list
- *                                   and add to NS mem track
- *   @param    ipa                 - IPA which needs to remove from data list
- *   @return   Returns the node from data list
+ *   @brief    Returns the end of the IPA range covered by an RTT
+ *   @param    granule    - RTT granule
+ *   @return   First IPA after the range of the table
 **/
-val_host_granule_ts *val_host_remove_data_granule(val_host_granule_ts **gran_list_head,
-                                                                          uint64_t ipa)
+static uint64_t val_host_rtt_end(val_host_granule_ts *granule)
 {
-    val_host_granule_ts *current = *gran_list_head, *prev = NULL, *temp = NULL;
+    return VAL_HOST_GRANULE_IPA(granule) +
+           (val_host_rtt_level_mapsize(VAL_HOST_GRANULE_FIELD(granule, LEVEL)) << 9);
+}
 
-    temp = mem_track[0].gran_type.ns;
-    if ((current != NULL) && (current->ipa == ipa))
-    {
-        if (temp == *gran_list_head)
-        {
-            head = current->next;
-            mem_track[0].gran_type.ns = head;
-            current->next = NULL;
-            return current;
-        } else {
-            prev = current;
-            current = current->next;
-            *gran_list_head = current;
-            prev->next = NULL;
-            return prev;
-        }
-    }
+/**
+ *   @brief    Teardown order of two granules of the same list
+ *   @param    a          - First granule
+ *   @param    b          - Second granule
+ *   @param    rtt_order  - RTTs in post order (range end, then deeper level first),
+ *                          otherwise by IPA
+ *   @return   Returns true if b must be torn down before a
+**/
+static bool val_host_granule_before(val_host_granule_ts *a, val_host_granule_ts *b,
+                                    bool rtt_order)
+{
+    uint64_t end_a, end_b;
 
-    while (NULL != current)
-    {
-        if (current->ipa != ipa)
-        {
-            prev = current;
-            current = current->next;
-        } else {
-            break;
-        }
-    }
+    if (!rtt_order)
+        return VAL_HOST_GRANULE_IPA(b) < VAL_HOST_GRANULE_IPA(a);
 
-    if (current == NULL)
-        return NULL;
-    else if (current->ipa == ipa)
+    end_a = val_host_rtt_end(a);
+    end_b = val_host_rtt_end(b);
+    if (end_a != end_b)
+        return end_b < end_a;
+
+    return VAL_HOST_GRANULE_FIELD(b, LEVEL) > VAL_HOST_GRANULE_FIELD(a, LEVEL);
+}
+
+/**
+ *   @brief    Sorts a mem track list in place, bottom up merge sort over the
+ *             table indices, stable
+ *   @param    head       - List head, updated
+ *   @param    rtt_order  - Sort order, see val_host_granule_before
+ *   @return   void
+**/
+static void val_host_granule_list_sort(uint16_t *head, bool rtt_order)
+{
+    uint16_t p, q, e, tail, list = *head;
+    uint32_t insize = 1, nmerges, psize, qsize, i;
+
+    if (list == VAL_HOST_GRANULE_NONE)
+        return;
+
+    while (1)
     {
-        prev->next = current->next;
-        if (mem_track[0].gran_type.ns == *gran_list_head)
+        p = list;
+        list = VAL_HOST_GRANULE_NONE;
+        tail = VAL_HOST_GRANULE_NONE;
+        nmerges = 0;
+
+        while (p != VAL_HOST_GRANULE_NONE)
         {
-            if (current->next == NULL)
-                tail = prev;
+            nmerges++;
+            q = p;
+            psize = 0;
+            for (i = 0; i < insize; i++)
+            {
+                psize++;
+                q = granule_table[q].next;
+                if (q == VAL_HOST_GRANULE_NONE)
+                    break;
+            }
+            qsize = insize;
+
+            while (psize > 0 || (qsize > 0 && q != VAL_HOST_GRANULE_NONE))
+            {
+                if (psize == 0 || (qsize > 0 && q != VAL_HOST_GRANULE_NONE &&
+                    val_host_granule_before(&granule_table[p], &granule_table[q], rtt_order)))
+                {
+                    e = q;
+                    q = granule_table[q].next;
+                    qsize--;
+                } else {
+                    e = p;
+                    p = granule_table[p].next;
+                    psize--;
+                }
+
+                if (tail != VAL_HOST_GRANULE_NONE)
+                    granule_table[tail].next = e;
+                else
+                    list = e;
+                granule_table[e].prev = tail;
+                tail = e;
+            }
+            p = q;
         }
-        current->next = NULL;
-        return current;
-    } else {
-        return NULL;
+        granule_table[tail].next = VAL_HOST_GRANULE_NONE;
+
+        if (nmerges <= 1)
+            break;
+        insize *= 2;
     }
 
-    return NULL;
+    *head = list;
 }
 
 /**
- *   @brief    Remove data granule from data list and add to the NS mem_track
- *   @param    gran_list_head      - Data granule which needs to remove from data list
- *                                   and add to NS mem track
- *   @param    ipa                 - IPA which needs to remove from data list
- *   @return   Returns the node from data list
+ *   @brief    Destroys a data granule with its auxiliary mappings and releases it
+ *   @param    rd         - Realm RD
+ *   @param    idx        - Granule table index
+ *   @return   SUCCESS/FAILURE
 **/
-val_host_granule_ts *val_host_remove_rtt_granule(val_host_granule_ts **gran_list_head,
-                                                         uint64_t ipa, uint64_t level)
+static uint32_t val_host_destroy_data_granule(uint64_t rd, uint16_t idx)
 {
-    val_host_granule_ts *current = *gran_list_head, *prev = NULL, *temp = NULL;
+    val_host_granule_ts *curr_gran = &granule_table[idx];
+    uint64_t ipa = VAL_HOST_GRANULE_IPA(curr_gran);
+    uint64_t PA = val_host_granule_pa(idx);
+    val_host_data_destroy_ts data_destroy;
+    val_smc_param_ts cmd_ret;
+    uint64_t ret, i;
 
-    temp = mem_track[0].gran_type.ns;
-    if ((current != NULL) && (current->level == level) && (current->ipa == ipa))
+    /* Destroy mappings in Auxilliary Mapping */
+    for (i = 0; i < VAL_MAX_AUX_PLANES; i++)
     {
-        if (temp == *gran_list_head)
+        if (VAL_HOST_GRANULE_FIELD(curr_gran, AUX) & (1ULL << i))
         {
-            head = current->next;
-            mem_track[0].gran_type.ns = head;
-            current->next = NULL;
-            return current;
-        } else {
-            prev = current;
-            current = current->next;
-            *gran_list_head = current;
-            prev->next = NULL;
-            return prev;
+            cmd_ret = val_host_rmi_rtt_aux_unmap_protected(rd, ipa, i + 1);
+            if (cmd_ret.x0)
+            {
+                LOG(ERROR, "\tRTT_AUX_UNMAP_PROTECTED failed for ipa=0x%x, ret=0x%x\n",
+                                                              ipa, cmd_ret.x0);
+                return VAL_ERROR;
+            }
         }
     }
 
-    while (NULL != current)
+    ret = val_host_rmi_data_destroy(rd, ipa, &data_destroy);
+    if (ret)
     {
-        if ((current->level != level) || (current->ipa != ipa))
-        {
-            prev = current;
-            current = current->next;
-        } else {
-            break;
-        }
+        LOG(ERROR, "\tData destroy failed, data=0x%x, ret=0x%x\n", PA, ret);
+        return VAL_ERROR;
     }
 
-    if (current == NULL)
-        return NULL;
-    else if ((current->level == level) && (current->ipa == ipa))
+    ret = val_host_granule_release(PA);
+    if (ret)
     {
-        prev->next = current->next;
-        if (mem_track[0].gran_type.ns == *gran_list_head)
-        {
-            if (current->next == NULL)
-                tail = prev;
-        }
-        current->next = NULL;
-        return current;
-    } else {
-        return NULL;
+        LOG(ERROR, "\tdata undelegation failed, pa=0x%x, ret=0x%x\n", PA, ret);
+        return VAL_ERROR;
     }
 
-    return NULL;
+    return VAL_SUCCESS;
 }
 
 /**
- *   @brief    Remove data granule from data list and add to the NS mem_track
- *   @param    gran_list_head      - Data granule which needs to remove from data list
- *                                   and add to NS mem track
- *   @param    ipa                 - IPA which needs to remove from data list
- *   @return   Returns the node from data list
+ *   @brief    Destroys the data granules of a level 2 block mapping. DATA_DESTROY
+ *             needs a level 3 entry, so the block is split with a temporary RTT.
+ *   @param    rd         - Realm RD
+ *   @param    data       - Sorted data list position, first granule of the block.
+ *                          Advanced past the block.
+ *   @return   SUCCESS/FAILURE
 **/
-val_host_granule_ts *val_host_remove_aux_rtt_granule(val_host_granule_ts **gran_list_head,
-                                                uint64_t ipa, uint64_t level, uint64_t index)
+static uint32_t val_host_destroy_data_block(uint64_t rd, uint16_t *data)
 {
-    val_host_granule_ts *current = *gran_list_head, *prev = NULL, *temp = NULL;
+    uint64_t ipa = ADDR_ALIGN_DOWN(VAL_HOST_GRANULE_IPA(&granule_table[*data]),
+                                   VAL_RTT_L2_BLOCK_SIZE);
+    val_host_rtt_destroy_ts rtt_destroy;
+    uint64_t ret, rtt;
+    uint16_t next;
+    bool failed = false;
 
-    temp = mem_track[0].gran_type.ns;
-    if ((current != NULL) && (current->level == level) &&
-                             (current->ipa == ipa) && (current->rtt_tree_idx == index))
+    rtt = val_host_granule_get();
+    if (!rtt)
     {
-        if (temp == *gran_list_head)
-        {
-            head = current->next;
-            mem_track[0].gran_type.ns = head;
-            current->next = NULL;
-            return current;
-        } else {
-            prev = current;
-            current = current->next;
-            *gran_list_head = current;
-            prev->next = NULL;
-            return prev;
-        }
+        LOG(ERROR, "\tFailed to get a delegated granule for rtt\n", 0, 0);
+        return VAL_ERROR;
     }
 
-    while (NULL != current)
+    ret = val_host_rmi_rtt_create(rd, rtt, ipa, VAL_RTT_MAX_LEVEL);
+    if (ret)
     {
-        if ((current->level != level) || (current->ipa != ipa) || (current->rtt_tree_idx != index))
+        LOG(ERROR, "\tBlock split failed, ipa=0x%x, ret=0x%x\n", ipa, ret);
+        val_host_granule_put(rtt);
+        return VAL_ERROR;
+    }
+
+    while (*data != VAL_HOST_GRANULE_NONE &&
+           VAL_HOST_GRANULE_IPA(&granule_table[*data]) < ipa + VAL_RTT_L2_BLOCK_SIZE)
+    {
+        next = granule_table[*data].next;
+        if (val_host_destroy_data_granule(rd, *data))
         {
-            prev = current;
-            current = current->next;
-        } else {
+            failed = true;
             break;
         }
+        *data = next;
     }
 
-    if (current == NULL)
-        return NULL;
-    else if ((current->level == level) && (current->ipa == ipa) && (current->rtt_tree_idx == index))
+    /* Also on a data granule failure, the table goes if nothing is left in it */
+    ret = val_host_rmi_rtt_destroy(rd, ipa, VAL_RTT_MAX_LEVEL, &rtt_destroy);
+    if (ret)
     {
-        prev->next = current->next;
-        if (mem_track[0].gran_type.ns == *gran_list_head)
-        {
-            if (current->next == NULL)
-                tail = prev;
-        }
-        current->next = NULL;
-        return current;
-    } else {
-        return NULL;
+        LOG(ERROR, "\trealm_rtt_destroy failed, rtt=0x%x, ret=0x%x\n", rtt, ret);
+        return VAL_ERROR;
+    }
+
+    ret = val_host_granule_put(rtt);
+    if (ret)
+    {
+        LOG(ERROR, "\tRTT undelegation failed, rtt=0x%x, ret=0x%x\n", rtt, ret);
+        return VAL_ERROR;
     }
 
-    return NULL;
+    return failed ? VAL_ERROR : VAL_SUCCESS;
 }
 
 /**
- *   @brief    Destroy rtt levels
- *   @param    rtt_level      - RTT level to destroy
+ *   @brief    Destroys an RTT tree of a realm in a single address ordered walk.
+ *             Each table is destroyed as soon as its range is empty, data
+ *             granules of the primary tree are destroyed just before the
+ *             level 3 table holding them.
  *   @param    current_realm  - current realm index in mem track
+ *   @param    index          - 0 for the primary tree, else auxiliary tree index
  *   @return   SUCCESS/FAILURE
 **/
-uint64_t val_host_destroy_rtt_levels(uint64_t rtt_level, int current_realm)
+static uint32_t val_host_destroy_rtt_tree(int current_realm, uint64_t index)
 {
-    val_host_granule_ts *curr_gran = NULL, *next_gran = NULL;
-    uint64_t ret;
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+    val_host_memory_track_ts *mem_track = &track_ctx->mem_track[current_realm];
+    uint8_t list = index ? VAL_HOST_GRANULE_LIST_RTT_AUX : VAL_HOST_GRANULE_LIST_RTT;
+    val_host_granule_ts *curr_gran;
     val_host_rtt_destroy_ts rtt_destroy;
+    val_smc_param_ts cmd_ret;
+    uint16_t idx, next, data, next_data;
+    uint64_t ret, ipa, level, end, PA;
 
-    curr_gran = mem_track[current_realm].gran_type.rtt;
-    while (curr_gran != NULL)
+    val_host_granule_list_sort(&mem_track->list[list], true);
+    data = VAL_HOST_GRANULE_NONE;
+    if (!index)
     {
-        next_gran = curr_gran->next;
-        if (curr_gran->level == rtt_level)
+        val_host_granule_list_sort(&mem_track->list[VAL_HOST_GRANULE_LIST_DATA], false);
+        data = mem_track->list[VAL_HOST_GRANULE_LIST_DATA];
+    }
+
+    idx = mem_track->list[list];
+    while (idx != VAL_HOST_GRANULE_NONE)
+    {
+        curr_gran = &granule_table[idx];
+        next = curr_gran->next;
+        if (index && VAL_HOST_GRANULE_FIELD(curr_gran, TREE) != index)
         {
+            idx = next;
+            continue;
+        }
 
-            ret = val_host_rmi_rtt_destroy(curr_gran->rd,
-                                           curr_gran->ipa, curr_gran->level, &rtt_destroy);
-            if (ret)
+        ipa = VAL_HOST_GRANULE_IPA(curr_gran);
+        level = VAL_HOST_GRANULE_FIELD(curr_gran, LEVEL);
+        end = val_host_rtt_end(curr_gran);
+        PA = val_host_granule_pa(idx);
+
+        /* Empty the range of the table */
+        while (data != VAL_HOST_GRANULE_NONE && VAL_HOST_GRANULE_IPA(&granule_table[data]) < end)
+        {
+            if (VAL_HOST_GRANULE_FIELD(&granule_table[data], LEVEL) == VAL_RTT_MAX_LEVEL - 1)
             {
-                LOG(ERROR, "\trealm_rtt_destroy failed, rtt=0x%x, ret=0x%x\n", curr_gran->ipa, ret);
-                return VAL_ERROR;
+                if (val_host_destroy_data_block(mem_track->rd, &data))
+                    return VAL_ERROR;
+                continue;
             }
-            ret = val_host_rmi_granule_undelegate(curr_gran->PA);
-            if (ret)
-            {
-                LOG(ERROR, "\tval_rmi_granule_undelegate failed, rtt=0x%x, ret=0x%x\n",
-                                                                   curr_gran->PA, ret);
+
+            next_data = granule_table[data].next;
+            if (val_host_destroy_data_granule(mem_track->rd, data))
                 return VAL_ERROR;
-            }
+            data = next_data;
+        }
 
-            curr_gran = next_gran;
+        if (index)
+        {
+            cmd_ret = val_host_rmi_rtt_aux_destroy(mem_track->rd, ipa, level, index);
+            ret = cmd_ret.x0;
         } else {
-            curr_gran = next_gran;
+            ret = val_host_rmi_rtt_destroy(mem_track->rd, ipa, level, &rtt_destroy);
         }
-    }
-    return VAL_SUCCESS;
-}
 
-/**
- *   @brief    Destroy auxiliary rtt levels
- *   @param    rtt_level      - RTT level to destroy
- *   @param    current_realm  - current realm index in mem track
- *   @return   SUCCESS/FAILURE
-**/
-uint64_t val_host_destroy_aux_rtt_levels(uint64_t rtt_level, int current_realm, uint64_t index)
-{
-    val_host_granule_ts *curr_gran = NULL, *next_gran = NULL;
-    uint64_t ret;
-    val_smc_param_ts cmd_ret;
-
-    curr_gran = mem_track[current_realm].gran_type.rtt_aux;
-    while (curr_gran != NULL)
-    {
-        next_gran = curr_gran->next;
-        if ((curr_gran->level == rtt_level) && (curr_gran->rtt_tree_idx == index))
+        if (ret)
         {
+            LOG(ERROR, "\trealm_rtt_destroy failed, rtt=0x%x, ret=0x%x\n", ipa, ret);
+            return VAL_ERROR;
+        }
 
-            cmd_ret = val_host_rmi_rtt_aux_destroy(curr_gran->rd,
-                                           curr_gran->ipa, curr_gran->level, index);
-            if (cmd_ret.x0)
-            {
-                LOG(ERROR, "\trealm_rtt_destroy failed, rtt=0x%x, ret=0x%x\n", curr_gran->ipa,
-                                                                                 cmd_ret.x0);
-                return VAL_ERROR;
-            }
+        ret = val_host_granule_release(PA);
+        if (ret)
+        {
+            LOG(ERROR, "\tval_rmi_granule_undelegate failed, rtt=0x%x, ret=0x%x\n",
+                                                               PA, ret);
+            return VAL_ERROR;
+        }
+        idx = next;
+    }
 
-            ret = val_host_rmi_granule_undelegate(curr_gran->PA);
-            if (ret)
-            {
-                LOG(ERROR, "\tval_rmi_granule_undelegate failed, rtt=0x%x, ret=0x%x\n",
-                                                                   curr_gran->PA, ret);
+    /* Data in tables the tracker does not own, e.g. the starting level */
+    while (data != VAL_HOST_GRANULE_NONE)
+    {
+        if (VAL_HOST_GRANULE_FIELD(&granule_table[data], LEVEL) == VAL_RTT_MAX_LEVEL - 1)
+        {
+            if (val_host_destroy_data_block(mem_track->rd, &data))
                 return VAL_ERROR;
-            }
-
-            curr_gran = next_gran;
-        } else {
-            curr_gran = next_gran;
+            continue;
         }
+
+        next_data = granule_table[data].next;
+        if (val_host_destroy_data_granule(mem_track->rd, data))
+            return VAL_ERROR;
+        data = next_data;
     }
+
     return VAL_SUCCESS;
 }
 
@@ -2080,15 +2488,16 @@ uint64_t val_host_destroy_aux_rtt_levels(uint64_t rtt_level, int current_realm,
 **/
 uint64_t val_host_postamble(void)
 {
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
     int i;
-    uint64_t ret;
-    val_host_granule_ts *curr_gran = NULL, *next_gran = NULL;
+    uint64_t ret, PA;
+    uint16_t idx, next;
 
     for (i = 1 ; i < VAL_HOST_MAX_REALMS ; i++)
     {
-        if (mem_track[i].rd != 0x00000000FFFFFFFF)
+        if (track_ctx->mem_track[i].rd != 0x00000000FFFFFFFF)
         {
-            ret = val_host_realm_destroy((uint64_t)mem_track[i].rd);
+            ret = val_host_realm_destroy((uint64_t)track_ctx->mem_track[i].rd);
             if (ret)
             {
                 LOG(ERROR, "\tval_host_realm_destroy failed, ret=0x%x\n", ret, 0);
@@ -2097,48 +2506,23 @@ uint64_t val_host_postamble(void)
         }
     }
 
-    //Undelegate and free all other granules in NS mem_track
-    curr_gran = mem_track[0].gran_type.ns;
-    while (curr_gran != NULL)
+    //Release all other granules in NS mem_track, pool granules stay delegated
+    idx = track_ctx->mem_track[0].list[VAL_HOST_GRANULE_LIST_NS];
+    while (idx != VAL_HOST_GRANULE_NONE)
     {
-        if (curr_gran->state == GRANULE_DELEGATED)
+        next = granule_table[idx].next;
+        if (VAL_HOST_GRANULE_FIELD(&granule_table[idx], STATE) == GRANULE_DELEGATED)
         {
-            next_gran = curr_gran->next;
-            ret = val_host_rmi_granule_undelegate(curr_gran->PA);
+            PA = val_host_granule_pa(idx);
+            ret = val_host_granule_release(PA);
             if (ret)
             {
                 LOG(ERROR, "\tgranule undelegation failed, pa=0x%x, ret=0x%x\n",
-                                                            curr_gran->PA, ret);
+                                                            PA, ret);
                 return VAL_ERROR;
             }
-            curr_gran = next_gran;
-        } else {
-            curr_gran = curr_gran->next;
-        }
-    }
-
-    //Free remaining memory from list
-    val_host_granule_ts *node_temp1 = NULL;
-
-    curr_gran = mem_track[0].gran_type.ns;
-    if (curr_gran == NULL)
-    {
-        return VAL_SUCCESS;
-    } else {
-        while (curr_gran != NULL)
-        {
-            if (curr_gran->state == GRANULE_UNDELEGATED)
-            {
-                next_gran = curr_gran->next;
-                node_temp1 = val_host_remove_granule(&mem_track[0].gran_type.ns, curr_gran->PA);
-                val_host_mem_free((void *)node_temp1->PA);
-                val_host_mem_free(node_temp1);
-                curr_gran = next_gran;
-
-            } else {
-                curr_gran = curr_gran->next;
-            }
         }
+        idx = next;
     }
 
     return VAL_SUCCESS;
@@ -2151,155 +2535,76 @@ uint64_t val_host_postamble(void)
 **/
 uint32_t val_host_realm_destroy(uint64_t rd)
 {
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
     uint64_t ret;
     val_smc_param_ts cmd_ret;
-    val_host_granule_ts *curr_gran = NULL, *next_gran = NULL;
-    val_host_data_destroy_ts data_destroy;
-    current_realm = val_host_get_curr_realm(rd);
-    uint64_t top;
+    val_host_unprot_map_ts *unprot;
+    track_ctx->current_realm = val_host_get_curr_realm(rd);
+    int realm = track_ctx->current_realm;
+    uint16_t idx, next, run;
+    uint64_t top, PA;
     uint64_t i;
 
     /* For each REC - Destroy, undelegate */
-    curr_gran = mem_track[current_realm].gran_type.rec;
-    while (curr_gran != NULL)
+    idx = track_ctx->mem_track[realm].list[VAL_HOST_GRANULE_LIST_REC];
+    while (idx != VAL_HOST_GRANULE_NONE)
     {
-        next_gran = curr_gran->next;
-        ret = val_host_rmi_rec_destroy(curr_gran->PA);
+        next = granule_table[idx].next;
+        run = granule_table[idx].run;
+        PA = val_host_granule_pa(idx);
+        ret = val_host_rmi_rec_destroy(PA);
         if (ret)
         {
-            LOG(ERROR, "\tREC destroy failed, rec=0x%x, ret=0x%x\n", curr_gran->PA, ret);
+            LOG(ERROR, "\tREC destroy failed, rec=0x%x, ret=0x%x\n", PA, ret);
             return VAL_ERROR;
         }
 
-        ret = val_host_rmi_granule_undelegate(curr_gran->PA);
+        ret = val_host_granule_put(PA);
         if (ret)
         {
-            LOG(ERROR, "\trec undelegation failed, rec=0x%x, ret=0x%x\n", curr_gran->PA, ret);
+            LOG(ERROR, "\trec undelegation failed, rec=0x%x, ret=0x%x\n", PA, ret);
             return VAL_ERROR;
         }
-       curr_gran = next_gran;
-    }
 
-    // Destroy and undelegate realm protected granules
-    curr_gran = mem_track[current_realm].gran_type.data;
-    while (curr_gran != NULL)
-    {
-        next_gran = curr_gran->next;
-        if (curr_gran->is_granule_sliced == 1)
-        {
-
-            for (i = 0; i < VAL_MAX_AUX_PLANES; i++)
-            {
-                if (curr_gran->has_auxiliary[i])
-                {
-                    cmd_ret = val_host_rmi_rtt_aux_unmap_protected(curr_gran->rd,
-                                                               curr_gran->ipa, i + 1);
-                    if (cmd_ret.x0)
-                    {
-                        LOG(ERROR, "\tRTT_AUX_UNMAP_PROTECTED failed for ipa=0x%x, ret=0x%x\n",
-                                                                   curr_gran->ipa, cmd_ret.x0);
-                        return VAL_ERROR;
-                    }
-                }
-            }
-
-            ret = val_host_rmi_data_destroy(curr_gran->rd, curr_gran->ipa, &data_destroy);
-            if (ret)
-            {
-                LOG(ERROR, "\tData destroy failed, data=0x%x, ret=0x%x\n", curr_gran->PA, ret);
-                return VAL_ERROR;
-            }
-
-            ret = val_host_rmi_granule_undelegate(curr_gran->PA);
-            if (ret)
-            {
-                LOG(ERROR, "\tdata undelegation failed, pa=0x%x, ret=0x%x\n", curr_gran->PA, ret);
-                return VAL_ERROR;
-            }
-        }
-        curr_gran = next_gran;
-    }
-
-    curr_gran = mem_track[current_realm].gran_type.data;
-    while (curr_gran != NULL)
-    {
-        next_gran = curr_gran->next;
-        if (curr_gran->is_granule_sliced == 0)
-        {
-            /* Destroy mappings in Auxilliary Mapping */
-            for (i = 0; i < VAL_MAX_AUX_PLANES; i++)
-            {
-                if (curr_gran->has_auxiliary[i])
-                {
-                    cmd_ret = val_host_rmi_rtt_aux_unmap_protected(curr_gran->rd,
-                                                               curr_gran->ipa, i + 1);
-                    if (cmd_ret.x0)
-                    {
-                        LOG(ERROR, "\tRTT_AUX_UNMAP_PROTECTED failed for ipa=0x%x, ret=0x%x\n",
-                                                                      curr_gran->ipa, cmd_ret.x0);
-                        return VAL_ERROR;
-                    }
-                }
-            }
-
-            ret = val_host_rmi_data_destroy(curr_gran->rd, curr_gran->ipa, &data_destroy);
-            if (ret)
-            {
-                LOG(ERROR, "\tData destroy failed, data=0x%x, ret=0x%x\n", curr_gran->PA, ret);
-                return VAL_ERROR;
-            }
-
-            ret = val_host_rmi_granule_undelegate(curr_gran->PA);
-            if (ret)
-            {
-                LOG(ERROR, "\tdata undelegation failed, pa=0x%x, ret=0x%x\n", curr_gran->PA, ret);
-                return VAL_ERROR;
-            }
-            curr_gran = next_gran;
-        } else {
-            curr_gran = next_gran;
-        }
+        if (run != VAL_HOST_GRANULE_NONE)
+            val_host_mem_free((void *)val_host_granule_pa(run));
+        idx = next;
     }
 
     // Unmap unprotected granules
-    curr_gran = mem_track[current_realm].gran_type.valid_ns;
-    while (curr_gran != NULL)
+    idx = track_ctx->mem_track[realm].valid_ns;
+    while (idx != VAL_HOST_GRANULE_NONE)
     {
-        next_gran = curr_gran->next;
+        unprot = &unprot_arena[idx];
+        next = unprot->next;
 
         /* Unmap Auxilliary mappings for Unprotected IPA */
         for (i = 0; i < VAL_MAX_AUX_PLANES; i++)
         {
-            if (curr_gran->has_auxiliary[i])
+            if (unprot->aux & (1U << i))
             {
-                cmd_ret = val_host_rmi_rtt_aux_unmap_unprotected(curr_gran->rd,
-                                                             curr_gran->ipa, i + 1);
+                cmd_ret = val_host_rmi_rtt_aux_unmap_unprotected(rd, unprot->ipa, i + 1);
                 if (cmd_ret.x0)
                 {
                     LOG(ERROR, "\tval_rmi_rtt_aux_unmap_unprotected failed, ipa=0x%x, ret=0x%x\n",
-                                                                     curr_gran->ipa, cmd_ret.x0);
+                                                                     unprot->ipa, cmd_ret.x0);
                     return VAL_ERROR;
                 }
             }
         }
 
-        ret = val_host_rmi_rtt_unmap_unprotected(curr_gran->rd, curr_gran->ipa,
-                                                       curr_gran->level, &top);
+        ret = val_host_rmi_rtt_unmap_unprotected(rd, unprot->ipa, unprot->level, &top);
         if (ret)
         {
             LOG(ERROR, "\tval_rmi_rtt_unmap_unprotected failed, ipa=0x%x, ret=0x%x\n",
-                                                                 curr_gran->ipa, ret);
+                                                                 unprot->ipa, ret);
             return VAL_ERROR;
         }
-        curr_gran = next_gran;
+        idx = next;
     }
 
-    // Destroy leaf rtt hirerachy
-    if (val_host_destroy_rtt_levels(3, current_realm))
-        return VAL_ERROR;
-    if (val_host_destroy_rtt_levels(2, current_realm))
-        return VAL_ERROR;
-    if (val_host_destroy_rtt_levels(1, current_realm))
+    // Destroy protected data and the rtt hierarchy in one walk
+    if (val_host_destroy_rtt_tree(realm, 0))
         return VAL_ERROR;
 
 #ifdef RMM_V_1_1
@@ -2308,21 +2613,17 @@ uint32_t val_host_realm_destroy(uint64_t rd)
     {
         for (i = 0; i < VAL_MAX_AUX_PLANES; i++)
         {
-                if (val_host_destroy_aux_rtt_levels(3, current_realm, i + 1))
-                    return VAL_ERROR;
-                if (val_host_destroy_aux_rtt_levels(2, current_realm, i + 1))
-                    return VAL_ERROR;
-                if (val_host_destroy_aux_rtt_levels(1, current_realm, i + 1))
-                    return VAL_ERROR;
+            if (val_host_destroy_rtt_tree(realm, i + 1))
+                return VAL_ERROR;
         }
     }
 #endif
 
     // RD destroy, undelegate and free
-    ret = val_host_rmi_realm_destroy(mem_track[current_realm].rd);
+    ret = val_host_rmi_realm_destroy(track_ctx->mem_track[realm].rd);
     if (ret)
     {
-        LOG(ERROR, "\tRealm destroy failed, rd=0x%x, ret=0x%x\n", mem_track[current_realm].rd, ret);
+        LOG(ERROR, "\tRealm destroy failed, rd=0x%x, ret=0x%x\n", track_ctx->mem_track[realm].rd, ret);
         return VAL_ERROR;
     }
 
@@ -2336,21 +2637,38 @@ uint32_t val_host_realm_destroy(uint64_t rd)
 **/
 void val_host_reset_mem_tack(void)
 {
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+    uint32_t base, count, hash_base, hash_count;
+    uint32_t i = 0, j;
 
-    uint32_t i = 0;
+    track_ctx->current_realm = 1;
+    val_memset(&track_ctx->stats, 0, sizeof(track_ctx->stats));
+
+    /* Bulk reset of the unprotected mapping arena */
+    val_host_unprot_slice(&base, &count);
+    for (j = 0; j < count; j++)
+        unprot_arena[base + j].next = (j + 1 < count) ?
+                                      (uint16_t)(base + j + 1) : VAL_HOST_GRANULE_NONE;
+    track_ctx->unprot_free = (uint16_t)base;
+
+    /* Only the slice of the calling context, others may be running */
+    val_host_granule_slice(&base, &count, &hash_base, &hash_count);
+    val_memset(&granule_table[base], 0, count * sizeof(val_host_granule_ts));
+    base = (uint32_t)((VAL_HOST_POOL_BASE(val_get_ctx_id()) - PLATFORM_HEAP_REGION_BASE) /
+                      PAGE_SIZE);
+    val_memset(&granule_table[base], 0, VAL_HOST_POOL_GRANULES * sizeof(val_host_granule_ts));
+    val_memset(&granule_hash[hash_base], 0xFF, hash_count * sizeof(uint16_t));
 
     while (i < VAL_HOST_MAX_REALMS)
     {
         /* Reset mem_track.rd to default value */
-        mem_track[i].rd = 0x00000000FFFFFFFF;
+        track_ctx->mem_track[i].rd = 0x00000000FFFFFFFF;
+        track_ctx->mem_track[i].rtt_start = VAL_HOST_RTT_START_NONE;
 
-        /* Reset mem_track.gran_type.* linked lists */
-        mem_track[i].gran_type.ns = NULL;
-        mem_track[i].gran_type.rd = NULL;
-        mem_track[i].gran_type.rtt = NULL;
-        mem_track[i].gran_type.rec = NULL;
-        mem_track[i].gran_type.data = NULL;
-        mem_track[i].gran_type.valid_ns = NULL;
+        /* Reset mem_track lists */
+        for (j = 0; j < VAL_HOST_GRANULE_LIST_COUNT; j++)
+            track_ctx->mem_track[i].list[j] = VAL_HOST_GRANULE_NONE;
+        track_ctx->mem_track[i].valid_ns = VAL_HOST_GRANULE_NONE;
 
         i++;
     }
@@ -2368,37 +2686,48 @@ void val_host_reset_mem_tack(void)
 uint64_t val_host_update_aux_rtt_info(uint64_t gran_state, uint64_t rd,
                                       uint64_t rtt_index, uint64_t ipa, bool val)
 {
-    /* Get current realm index from rd */
-    current_realm = val_host_get_curr_realm(rd);
-
-    val_host_granule_ts *current = NULL;
+    val_host_mem_track_ctx_ts *track_ctx = val_host_get_mem_track_ctx();
+    val_host_granule_ts *granule;
+    uint64_t aux_bit;
+    uint32_t hslot;
+    uint16_t node;
 
-    /* Track the appropriate linked list based on the target granule state */
-    if (gran_state == GRANULE_DATA) {
-        current = mem_track[current_realm].gran_type.data;
-    } else if (gran_state == GRANULE_UNPROTECTED) {
-        current = mem_track[current_realm].gran_type.valid_ns;
-    } else {
+    if (rtt_index == 0 || rtt_index > VAL_MAX_AUX_PLANES)
         return VAL_ERROR;
-    }
 
-    /* Linked list cannot be empty*/
-    if (current == NULL)
-        return VAL_ERROR;
+    /* Get current realm index from rd */
+    track_ctx->current_realm = val_host_get_curr_realm(rd);
 
-    /* Search for the node and update the information */
-    do
+    if (gran_state == GRANULE_DATA)
     {
-        if (current->ipa == ipa) {
-            break;
-        } else {
-            current = current->next;
-        }
-    } while (current != NULL);
+        hslot = val_host_hash_find((uint8_t)track_ctx->current_realm, ipa);
+        if (hslot == VAL_HOST_GRANULE_HASH_SIZE)
+            return VAL_ERROR;
 
-    current->has_auxiliary[rtt_index - 1] = val;
+        granule = &granule_table[granule_hash[hslot]];
+        aux_bit = 1ULL << (VAL_HOST_GRANULE_AUX_SHIFT + rtt_index - 1);
+        if (val)
+            granule->ipa |= aux_bit;
+        else
+            granule->ipa &= ~aux_bit;
 
-    return VAL_SUCCESS;
+        return VAL_SUCCESS;
+    } else if (gran_state == GRANULE_UNPROTECTED) {
+        node = track_ctx->mem_track[track_ctx->current_realm].valid_ns;
+        while (node != VAL_HOST_GRANULE_NONE && unprot_arena[node].ipa != ipa)
+            node = unprot_arena[node].next;
+
+        if (node == VAL_HOST_GRANULE_NONE)
+            return VAL_ERROR;
+
+        if (val)
+            unprot_arena[node].aux = (uint8_t)(unprot_arena[node].aux | (1U << (rtt_index - 1)));
+        else
+            unprot_arena[node].aux = (uint8_t)(unprot_arena[node].aux & ~(1U << (rtt_index - 1)));
+        return VAL_SUCCESS;
+    }
+
+    return VAL_ERROR;
 }
 
 /* Checks RMM support for multi plane realms
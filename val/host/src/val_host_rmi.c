@@ -8,6 +8,185 @@
 #include "val_host_rmi.h"
 #include "val_libc.h"
 #include "val_host_realm.h"
+#include "val_timer.h"
+
+#if defined(RMI_PROFILE)
+#define VAL_HOST_RMI_NAME(fid)  [(fid) - VAL_HOST_RMI_FID_BASE] = #fid
+
+static const char *const rmi_profile_name[VAL_HOST_RMI_FID_COUNT] = {
+    VAL_HOST_RMI_NAME(RMI_VERSION),
+    VAL_HOST_RMI_NAME(RMI_GRANULE_DELEGATE),
+    VAL_HOST_RMI_NAME(RMI_GRANULE_UNDELEGATE),
+    VAL_HOST_RMI_NAME(RMI_DATA_CREATE),
+    VAL_HOST_RMI_NAME(RMI_DATA_CREATE_UNKNOWN),
+    VAL_HOST_RMI_NAME(RMI_DATA_DESTROY),
+    VAL_HOST_RMI_NAME(RMI_REALM_ACTIVATE),
+    VAL_HOST_RMI_NAME(RMI_REALM_CREATE),
+    VAL_HOST_RMI_NAME(RMI_REALM_DESTROY),
+    VAL_HOST_RMI_NAME(RMI_REC_CREATE),
+    VAL_HOST_RMI_NAME(RMI_REC_DESTROY),
+    VAL_HOST_RMI_NAME(RMI_REC_ENTER),
+    VAL_HOST_RMI_NAME(RMI_RTT_CREATE),
+    VAL_HOST_RMI_NAME(RMI_RTT_DESTROY),
+    VAL_HOST_RMI_NAME(RMI_RTT_MAP_UNPROTECTED),
+    VAL_HOST_RMI_NAME(RMI_RTT_READ_ENTRY),
+    VAL_HOST_RMI_NAME(RMI_RTT_UNMAP_UNPROTECTED),
+    VAL_HOST_RMI_NAME(RMI_PSCI_COMPLETE),
+    VAL_HOST_RMI_NAME(RMI_FEATURES),
+    VAL_HOST_RMI_NAME(RMI_RTT_FOLD),
+    VAL_HOST_RMI_NAME(RMI_REC_AUX_COUNT),
+    VAL_HOST_RMI_NAME(RMI_RTT_INIT_RIPAS),
+    VAL_HOST_RMI_NAME(RMI_RTT_SET_RIPAS),
+    VAL_HOST_RMI_NAME(RMI_GRANULE_IO_DELEGATE),
+    VAL_HOST_RMI_NAME(RMI_GRANULE_IO_UNDELEGATE),
+    VAL_HOST_RMI_NAME(RMI_IO_CREATE),
+    VAL_HOST_RMI_NAME(RMI_IO_DESTROY),
+    VAL_HOST_RMI_NAME(RMI_PDEV_ABORT),
+    VAL_HOST_RMI_NAME(RMI_PDEV_COMMUNICATE),
+    VAL_HOST_RMI_NAME(RMI_PDEV_CREATE),
+    VAL_HOST_RMI_NAME(RMI_PDEV_DESTROY),
+    VAL_HOST_RMI_NAME(RMI_PDEV_GET_STATE),
+    VAL_HOST_RMI_NAME(RMI_PDEV_IDE_RESET),
+    VAL_HOST_RMI_NAME(RMI_PDEV_NOTIFY),
+    VAL_HOST_RMI_NAME(RMI_PDEV_SET_KEY),
+    VAL_HOST_RMI_NAME(RMI_PDEV_STOP),
+    VAL_HOST_RMI_NAME(RMI_RTT_AUX_CREATE),
+    VAL_HOST_RMI_NAME(RMI_RTT_AUX_DESTROY),
+    VAL_HOST_RMI_NAME(RMI_RTT_AUX_FOLD),
+    VAL_HOST_RMI_NAME(RMI_RTT_AUX_MAP_PROTECTED),
+    VAL_HOST_RMI_NAME(RMI_RTT_AUX_MAP_UNPROTECTED),
+    VAL_HOST_RMI_NAME(RMI_RTT_AUX_UNMAP_PROTECTED),
+    VAL_HOST_RMI_NAME(RMI_RTT_AUX_UNMAP_UNPROTECTED),
+    VAL_HOST_RMI_NAME(RMI_VDEV_ABORT),
+    VAL_HOST_RMI_NAME(RMI_VDEV_COMMUNICATE),
+    VAL_HOST_RMI_NAME(RMI_VDEV_CREATE),
+    VAL_HOST_RMI_NAME(RMI_VDEV_DESTROY),
+    VAL_HOST_RMI_NAME(RMI_VDEV_GET_STATE),
+    VAL_HOST_RMI_NAME(RMI_VDEV_STOP),
+    VAL_HOST_RMI_NAME(RMI_RTT_SET_S2AP),
+    VAL_HOST_RMI_NAME(RMI_MEC_SET_SHARED),
+    VAL_HOST_RMI_NAME(RMI_MEC_SET_PRIVATE),
+};
+
+/* Per cpu so that concurrent callers never share a slot */
+static val_host_rmi_profile_ts rmi_profile[PLATFORM_CPU_COUNT][VAL_HOST_RMI_FID_COUNT];
+
+/**
+ *   @brief    Accounts one RMI call latency into the profile of the calling cpu
+ *   @param    fid      -  RMI function ID
+ *   @param    ticks    -  Call latency in system counter ticks
+ *   @return   void
+**/
+static void val_host_rmi_profile_update(uint64_t fid, uint64_t ticks)
+{
+    uint32_t cpuid = val_get_cpuid(val_read_mpidr());
+    uint32_t bucket;
+    val_host_rmi_profile_ts *prof;
+
+    if (fid < VAL_HOST_RMI_FID_BASE || fid >= VAL_HOST_RMI_FID_BASE + VAL_HOST_RMI_FID_COUNT ||
+        cpuid >= PLATFORM_CPU_COUNT)
+        return;
+
+    prof = &rmi_profile[cpuid][fid - VAL_HOST_RMI_FID_BASE];
+    if (!prof->count || ticks < prof->min)
+        prof->min = ticks;
+    if (ticks > prof->max)
+        prof->max = ticks;
+    prof->count++;
+    prof->total += ticks;
+
+    bucket = ticks ? (uint32_t)(63 - __builtin_clzll(ticks)) : 0;
+    if (bucket >= VAL_HOST_RMI_HIST_BUCKETS)
+        bucket = VAL_HOST_RMI_HIST_BUCKETS - 1;
+    prof->hist[bucket]++;
+}
+
+/**
+ *   @brief    Clears the RMI profile of all cpus
+ *   @param    void
+ *   @return   void
+**/
+void val_host_rmi_profile_reset(void)
+{
+    val_memset(rmi_profile, 0, sizeof(rmi_profile));
+}
+
+/**
+ *   @brief    Prints call count, min/mean/max latency and the log2 latency
+ *             histogram of every RMI command issued so far, merged over all cpus
+ *   @param    void
+ *   @return   void
+**/
+void val_host_rmi_profile_dump(void)
+{
+    val_host_rmi_profile_ts sum;
+    uint32_t fid, cpu, i;
+
+    LOG(ALWAYS, "\nRMI PROFILE (system counter ticks, freq %d Hz): \n",
+        val_read_cntfrq_el0(), 0);
+    LOG(ALWAYS, "==================\n", 0, 0);
+
+    for (fid = 0; fid < VAL_HOST_RMI_FID_COUNT; fid++)
+    {
+        val_memset(&sum, 0, sizeof(sum));
+        for (cpu = 0; cpu < PLATFORM_CPU_COUNT; cpu++)
+        {
+            val_host_rmi_profile_ts *prof = &rmi_profile[cpu][fid];
+
+            if (!prof->count)
+                continue;
+
+            if (!sum.count || prof->min < sum.min)
+                sum.min = prof->min;
+            if (prof->max > sum.max)
+                sum.max = prof->max;
+            sum.count += prof->count;
+            sum.total += prof->total;
+            for (i = 0; i < VAL_HOST_RMI_HIST_BUCKETS; i++)
+                sum.hist[i] += prof->hist[i];
+        }
+
+        if (!sum.count)
+            continue;
+
+        LOG_VAR(ALWAYS, rmi_profile_name[fid] ? rmi_profile_name[fid] : "RMI_UNKNOWN", 0, 0);
+        LOG(ALWAYS, " (0x%x)\n", fid + VAL_HOST_RMI_FID_BASE, 0);
+        LOG(ALWAYS, "   count %d, mean %d", sum.count, sum.total / sum.count);
+        LOG(ALWAYS, ", min %d, max %d\n", sum.min, sum.max);
+        LOG(ALWAYS, "   hist", 0, 0);
+        for (i = 0; i < VAL_HOST_RMI_HIST_BUCKETS; i++)
+        {
+            if (sum.hist[i])
+                LOG(ALWAYS, " 2^%d:%d", i, sum.hist[i]);
+        }
+        LOG(ALWAYS, "\n", 0, 0);
+    }
+}
+#endif
+
+/**
+ *   @brief    Issues an RMI command, timing it when RMI_PROFILE is enabled
+ *   @param    fid      -  RMI function ID
+ *   @param    x1-x10   -  Command arguments
+ *   @return   Returns command output registers
+**/
+static val_smc_param_ts val_host_rmi_call(uint64_t fid, uint64_t x1, uint64_t x2,
+                         uint64_t x3, uint64_t x4, uint64_t x5,
+                         uint64_t x6, uint64_t x7, uint64_t x8,
+                         uint64_t x9, uint64_t x10)
+{
+#if defined(RMI_PROFILE)
+    val_smc_param_ts args;
+    uint64_t start = val_read_cntpct_el0();
+
+    args = val_smc_call(fid, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10);
+    val_host_rmi_profile_update(fid, val_read_cntpct_el0() - start);
+
+    return args;
+#else
+    return val_smc_call(fid, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10);
+#endif
+}
 
 /**
  *   @brief    Returns RMI version
@@ -19,7 +198,7 @@ uint64_t val_host_rmi_version(uint64_t req, val_host_rmi_version_ts *output)
 {
     val_smc_param_ts args;
 
-    args = (val_smc_call(RMI_VERSION, req, 0, 0, 0, 0, 0, 0, 0, 0, 0));
+    args = (val_host_rmi_call(RMI_VERSION, req, 0, 0, 0, 0, 0, 0, 0, 0, 0));
 
     output->lower = args.x1;
     output->higher = args.x2;
@@ -37,7 +216,7 @@ uint64_t val_host_rmi_features(uint64_t index, uint64_t *value)
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_FEATURES, index, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_FEATURES, index, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 
     *value = args.x1;
     return args.x0;
@@ -53,7 +232,7 @@ uint64_t val_host_rmi_rec_aux_count(uint64_t rd, uint64_t *aux_count)
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_REC_AUX_COUNT, rd, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_REC_AUX_COUNT, rd, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 
     *aux_count = args.x1;
     return args.x0;
@@ -74,7 +253,7 @@ uint64_t val_host_rmi_data_create(uint64_t rd, uint64_t data,
 {
     uint64_t ret;
 
-    ret = (val_smc_call(RMI_DATA_CREATE, rd, data, ipa, src, flags, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_DATA_CREATE, rd, data, ipa, src, flags, 0, 0, 0, 0, 0)).x0;
     if (ret)
     {
         return ret;
@@ -96,7 +275,7 @@ uint64_t val_host_rmi_data_create_unknown(uint64_t rd,
 {
     uint64_t ret;
 
-    ret = (val_smc_call(RMI_DATA_CREATE_UNKNOWN, rd, data, ipa, 0, 0, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_DATA_CREATE_UNKNOWN, rd, data, ipa, 0, 0, 0, 0, 0, 0, 0)).x0;
     if (ret)
     {
         return ret;
@@ -115,13 +294,14 @@ uint64_t val_host_rmi_granule_delegate(uint64_t addr)
 {
     uint64_t ret;
 
-    ret = (val_smc_call(RMI_GRANULE_DELEGATE, addr, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_GRANULE_DELEGATE, addr, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
     if (ret)
     {
         return ret;
     }
 
-    val_host_add_granule(GRANULE_DELEGATED, addr, NULL);
+    val_host_add_granule(GRANULE_DELEGATED, addr);
+    val_host_get_mem_track_ctx()->stats.delegated[VAL_HOST_GRANULE_LIST_NS]++;
 
     return ret;
 }
@@ -135,12 +315,13 @@ uint64_t val_host_rmi_granule_undelegate(uint64_t addr)
 {
     uint64_t ret;
 
-    ret = (val_smc_call(RMI_GRANULE_UNDELEGATE, addr, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_GRANULE_UNDELEGATE, addr, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
     if (ret)
     {
         return ret;
     }
     val_host_update_destroy_granule_state(0, addr, 0, 0, GRANULE_UNDELEGATED, 0, 0);
+    val_host_get_mem_track_ctx()->stats.undelegated[VAL_HOST_GRANULE_LIST_NS]++;
     return ret;
 }
 
@@ -155,7 +336,7 @@ uint64_t val_host_rmi_granule_undelegate(uint64_t addr)
 uint64_t val_host_rmi_psci_complete(uint64_t calling_rec,
                  uint64_t target_rec, uint64_t status)
 {
-    return (val_smc_call(RMI_PSCI_COMPLETE, calling_rec, target_rec, status,
+    return (val_host_rmi_call(RMI_PSCI_COMPLETE, calling_rec, target_rec, status,
                                                        0, 0, 0, 0, 0, 0, 0)).x0;
 }
 
@@ -166,7 +347,7 @@ uint64_t val_host_rmi_psci_complete(uint64_t calling_rec,
 **/
 uint64_t val_host_rmi_realm_activate(uint64_t rd)
 {
-    return (val_smc_call(RMI_REALM_ACTIVATE, rd, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
+    return (val_host_rmi_call(RMI_REALM_ACTIVATE, rd, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
 }
 
 /**
@@ -179,12 +360,13 @@ uint64_t val_host_rmi_realm_create(uint64_t rd, uint64_t params_ptr)
 {
     uint64_t ret;
 
-    ret = (val_smc_call(RMI_REALM_CREATE, rd, params_ptr, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_REALM_CREATE, rd, params_ptr, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
     if (ret)
     {
         return ret;
     }
     val_host_update_granule_state(rd, GRANULE_RD, rd, 0, 0, 0);
+    val_host_update_rtt_start(rd, ((val_host_realm_params_ts *)params_ptr)->rtt_level_start);
     return ret;
 }
 
@@ -197,7 +379,7 @@ uint64_t val_host_rmi_realm_destroy(uint64_t rd)
 {
     uint64_t ret;
 
-    ret = (val_smc_call(RMI_REALM_DESTROY, rd, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_REALM_DESTROY, rd, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
     if (ret)
     {
         return ret;
@@ -218,7 +400,7 @@ uint64_t val_host_rmi_data_destroy(uint64_t rd, uint64_t ipa,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_DATA_DESTROY, rd, ipa, 0, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_DATA_DESTROY, rd, ipa, 0, 0, 0, 0, 0, 0, 0, 0);
     data_destroy->data = args.x1;
     data_destroy->top = args.x2;
 
@@ -242,7 +424,7 @@ uint64_t val_host_rmi_rec_create(uint64_t rd, uint64_t rec,
 {
     uint64_t ret;
 
-    ret = (val_smc_call(RMI_REC_CREATE, rd, rec, params_ptr, 0, 0, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_REC_CREATE, rd, rec, params_ptr, 0, 0, 0, 0, 0, 0, 0)).x0;
     if (ret)
     {
         return ret;
@@ -260,7 +442,7 @@ uint64_t val_host_rmi_rec_destroy(uint64_t rec)
 {
     uint64_t ret;
 
-    ret = (val_smc_call(RMI_REC_DESTROY, rec, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_REC_DESTROY, rec, 0, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
     if (ret)
     {
         return ret;
@@ -282,7 +464,10 @@ uint64_t val_host_rmi_rec_enter(uint64_t rec, uint64_t run_ptr)
     uint64_t ret;
 
 rec_enter:
-    ret = (val_smc_call(RMI_REC_ENTER, rec, run_ptr, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_REC_ENTER, rec, run_ptr, 0, 0, 0, 0, 0, 0, 0, 0)).x0;
+
+    /* Any REC exit is a chance to print what the realm queued meanwhile */
+    val_host_realm_log_drain();
 
     /* In case of realm exit due to hvc print functionality,
      * re-enter rec after printing the realm message onto
@@ -313,7 +498,7 @@ rec_enter:
 **/
 val_smc_param_ts val_host_rmi_rtt_set_s2ap(uint64_t rd, uint64_t rec, uint64_t base, uint64_t top)
 {
-    return val_smc_call(RMI_RTT_SET_S2AP, rd, rec, base, top, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_RTT_SET_S2AP, rd, rec, base, top, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -329,12 +514,16 @@ uint64_t val_host_rmi_rtt_create(uint64_t rd, uint64_t rtt,
 {
     uint64_t ret;
 
-    ret = (val_smc_call(RMI_RTT_CREATE, rd, rtt, ipa, level, 0, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_RTT_CREATE, rd, rtt, ipa, level, 0, 0, 0, 0, 0, 0)).x0;
     if (ret)
     {
         return ret;
     }
     val_host_update_granule_state(rd, GRANULE_RTT, rtt, ipa, level, 0);
+
+    /* Splits a block, its data granules are page mapped again */
+    if (level == VAL_RTT_MAX_LEVEL)
+        val_host_update_data_level(rd, ipa, level);
     return ret;
 }
 
@@ -351,7 +540,7 @@ uint64_t val_host_rmi_rtt_fold(uint64_t rd,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_FOLD, rd, ipa, level, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_FOLD, rd, ipa, level, 0, 0, 0, 0, 0, 0, 0);
     if (args.x0)
     {
         return args.x0;
@@ -359,7 +548,12 @@ uint64_t val_host_rmi_rtt_fold(uint64_t rd,
 
     *rtt = args.x1;
 
-    val_host_update_destroy_granule_state(rd, 0, ipa, level, GRANULE_DELEGATED, GRANULE_RTT, 0);
+    val_host_update_destroy_granule_state(rd, args.x1, ipa, level, GRANULE_DELEGATED,
+                                                                    GRANULE_RTT, 0);
+
+    /* Data granules of an assigned range now sit behind a level 2 block */
+    if (level == VAL_RTT_MAX_LEVEL)
+        val_host_update_data_level(rd, ipa, level - 1);
     return args.x0;
 }
 
@@ -376,7 +570,7 @@ uint64_t val_host_rmi_rtt_destroy(uint64_t rd,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_DESTROY, rd, ipa, level, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_DESTROY, rd, ipa, level, 0, 0, 0, 0, 0, 0, 0);
     rtt_destroy->rtt = args.x1;
     rtt_destroy->top = args.x2;
 
@@ -385,7 +579,8 @@ uint64_t val_host_rmi_rtt_destroy(uint64_t rd,
         return args.x0;
     }
 
-    val_host_update_destroy_granule_state(rd, 0, ipa, level, GRANULE_DELEGATED, GRANULE_RTT, 0);
+    val_host_update_destroy_granule_state(rd, args.x1, ipa, level, GRANULE_DELEGATED,
+                                                                    GRANULE_RTT, 0);
     return args.x0;
 }
 
@@ -402,7 +597,7 @@ uint64_t val_host_rmi_rtt_map_unprotected(uint64_t rd, uint64_t ipa,
 {
     uint64_t ret;
 
-    ret = (val_smc_call(RMI_RTT_MAP_UNPROTECTED, rd, ipa, level, desc, 0, 0, 0, 0, 0, 0)).x0;
+    ret = (val_host_rmi_call(RMI_RTT_MAP_UNPROTECTED, rd, ipa, level, desc, 0, 0, 0, 0, 0, 0)).x0;
     if (ret)
     {
         return ret;
@@ -424,7 +619,7 @@ uint64_t val_host_rmi_rtt_read_entry(uint64_t rd, uint64_t ipa,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_READ_ENTRY, rd, ipa, level, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_READ_ENTRY, rd, ipa, level, 0, 0, 0, 0, 0, 0, 0);
 
     rtt->walk_level = args.x1;
     rtt->state = args.x2;
@@ -448,7 +643,7 @@ uint64_t val_host_rmi_rtt_unmap_unprotected(uint64_t rd, uint64_t ipa,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_UNMAP_UNPROTECTED, rd, ipa, level, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_UNMAP_UNPROTECTED, rd, ipa, level, 0, 0, 0, 0, 0, 0, 0);
     *top = args.x1;
 
     if (args.x0)
@@ -473,7 +668,7 @@ uint64_t val_host_rmi_rtt_init_ripas(uint64_t rd, uint64_t base,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_INIT_RIPAS, rd, base, top, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_INIT_RIPAS, rd, base, top, 0, 0, 0, 0, 0, 0, 0);
 
     *out_top = args.x1;
     return args.x0;
@@ -493,7 +688,7 @@ uint64_t val_host_rmi_rtt_set_ripas(uint64_t rd, uint64_t rec,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_SET_RIPAS, rd, rec, base, top, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_SET_RIPAS, rd, rec, base, top, 0, 0, 0, 0, 0, 0);
 
     *out_top = args.x1;
     return args.x0;
@@ -513,7 +708,7 @@ val_smc_param_ts val_host_rmi_rtt_aux_create(uint64_t rd, uint64_t rtt,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_AUX_CREATE, rd, rtt, ipa, level, index, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_AUX_CREATE, rd, rtt, ipa, level, index, 0, 0, 0, 0, 0);
 
     if (args.x0)
         return args;
@@ -537,12 +732,12 @@ val_smc_param_ts val_host_rmi_rtt_aux_destroy(uint64_t rd,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_AUX_DESTROY, rd, ipa, level, index, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_AUX_DESTROY, rd, ipa, level, index, 0, 0, 0, 0, 0, 0);
 
     if (args.x0)
         return args;
 
-    val_host_update_destroy_granule_state(rd, 0, ipa, level, GRANULE_DELEGATED,
+    val_host_update_destroy_granule_state(rd, args.x1, ipa, level, GRANULE_DELEGATED,
                                                              GRANULE_RTT_AUX, index);
 
     return args;
@@ -562,12 +757,12 @@ val_smc_param_ts val_host_rmi_rtt_aux_fold(uint64_t rd,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_AUX_FOLD, rd, ipa, level, index, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_AUX_FOLD, rd, ipa, level, index, 0, 0, 0, 0, 0, 0);
 
     if (args.x0)
         return args;
 
-    val_host_update_destroy_granule_state(rd, 0, ipa, level, GRANULE_DELEGATED,
+    val_host_update_destroy_granule_state(rd, args.x1, ipa, level, GRANULE_DELEGATED,
                                                              GRANULE_RTT_AUX, index);
     return args;
 }
@@ -583,7 +778,7 @@ val_smc_param_ts val_host_rmi_rtt_aux_map_protected(uint64_t rd, uint64_t ipa, u
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_AUX_MAP_PROTECTED, rd, ipa, index, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_AUX_MAP_PROTECTED, rd, ipa, index, 0, 0, 0, 0, 0, 0, 0);
 
     if (args.x0)
         return args;
@@ -604,7 +799,7 @@ val_smc_param_ts val_host_rmi_rtt_aux_map_unprotected(uint64_t rd, uint64_t ipa,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_AUX_MAP_UNPROTECTED, rd, ipa, index, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_AUX_MAP_UNPROTECTED, rd, ipa, index, 0, 0, 0, 0, 0, 0, 0);
 
     if (args.x0)
         return args;
@@ -627,7 +822,7 @@ val_smc_param_ts val_host_rmi_rtt_aux_unmap_protected(uint64_t rd, uint64_t ipa,
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_AUX_UNMAP_PROTECTED, rd, ipa, index, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_AUX_UNMAP_PROTECTED, rd, ipa, index, 0, 0, 0, 0, 0, 0, 0);
 
     if (args.x0)
         return args;
@@ -650,7 +845,7 @@ val_smc_param_ts val_host_rmi_rtt_aux_unmap_unprotected(uint64_t rd, uint64_t ip
 {
     val_smc_param_ts args;
 
-    args = val_smc_call(RMI_RTT_AUX_UNMAP_UNPROTECTED, rd, ipa, index, 0, 0, 0, 0, 0, 0, 0);
+    args = val_host_rmi_call(RMI_RTT_AUX_UNMAP_UNPROTECTED, rd, ipa, index, 0, 0, 0, 0, 0, 0, 0);
 
     if (args.x0)
         return args;
@@ -668,7 +863,7 @@ val_smc_param_ts val_host_rmi_rtt_aux_unmap_unprotected(uint64_t rd, uint64_t ip
 **/
 val_smc_param_ts val_host_rmi_granule_io_delegate(uint64_t addr, uint64_t flags)
 {
-    return val_smc_call(RMI_GRANULE_IO_DELEGATE, addr, flags, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_GRANULE_IO_DELEGATE, addr, flags, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -678,7 +873,7 @@ val_smc_param_ts val_host_rmi_granule_io_delegate(uint64_t addr, uint64_t flags)
 **/
 val_smc_param_ts val_host_rmi_granule_io_undelegate(uint64_t addr)
 {
-    return val_smc_call(RMI_GRANULE_IO_UNDELEGATE, addr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_GRANULE_IO_UNDELEGATE, addr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -691,7 +886,7 @@ val_smc_param_ts val_host_rmi_granule_io_undelegate(uint64_t addr)
 **/
 val_smc_param_ts val_host_rmi_io_create(uint64_t rd, uint64_t ipa, uint64_t flags, uint64_t desc)
 {
-    return val_smc_call(RMI_IO_CREATE, rd, ipa, flags, desc, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_IO_CREATE, rd, ipa, flags, desc, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -702,7 +897,7 @@ val_smc_param_ts val_host_rmi_io_create(uint64_t rd, uint64_t ipa, uint64_t flag
 **/
 val_smc_param_ts val_host_rmi_io_destroy(uint64_t rd, uint64_t ipa)
 {
-    return val_smc_call(RMI_IO_DESTROY, rd, ipa, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_IO_DESTROY, rd, ipa, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -712,7 +907,7 @@ val_smc_param_ts val_host_rmi_io_destroy(uint64_t rd, uint64_t ipa)
 **/
 val_smc_param_ts val_host_rmi_pdev_abort(uint64_t pdev_ptr)
 {
-    return val_smc_call(RMI_PDEV_ABORT, pdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_PDEV_ABORT, pdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -723,7 +918,7 @@ val_smc_param_ts val_host_rmi_pdev_abort(uint64_t pdev_ptr)
 **/
 val_smc_param_ts val_host_rmi_pdev_communicate(uint64_t pdev_ptr, uint64_t data_ptr)
 {
-    return val_smc_call(RMI_PDEV_COMMUNICATE, pdev_ptr, data_ptr, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_PDEV_COMMUNICATE, pdev_ptr, data_ptr, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -734,7 +929,7 @@ val_smc_param_ts val_host_rmi_pdev_communicate(uint64_t pdev_ptr, uint64_t data_
 **/
 val_smc_param_ts val_host_rmi_pdev_create(uint64_t pdev_ptr, uint64_t params_ptr)
 {
-    return val_smc_call(RMI_PDEV_CREATE, pdev_ptr, params_ptr, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_PDEV_CREATE, pdev_ptr, params_ptr, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -744,7 +939,7 @@ val_smc_param_ts val_host_rmi_pdev_create(uint64_t pdev_ptr, uint64_t params_ptr
 **/
 val_smc_param_ts val_host_rmi_pdev_destroy(uint64_t pdev_ptr)
 {
-    return val_smc_call(RMI_PDEV_DESTROY, pdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_PDEV_DESTROY, pdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -754,7 +949,7 @@ val_smc_param_ts val_host_rmi_pdev_destroy(uint64_t pdev_ptr)
 **/
 val_smc_param_ts val_host_rmi_pdev_get_state(uint64_t pdev_ptr)
 {
-    return val_smc_call(RMI_PDEV_GET_STATE, pdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_PDEV_GET_STATE, pdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -764,7 +959,7 @@ val_smc_param_ts val_host_rmi_pdev_get_state(uint64_t pdev_ptr)
 **/
 val_smc_param_ts val_host_rmi_pdev_ide_reset(uint64_t pdev_ptr)
 {
-    return val_smc_call(RMI_PDEV_IDE_RESET, pdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_PDEV_IDE_RESET, pdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -775,7 +970,7 @@ val_smc_param_ts val_host_rmi_pdev_ide_reset(uint64_t pdev_ptr)
 **/
 val_smc_param_ts val_host_rmi_pdev_notify(uint64_t pdev_ptr, uint64_t ev)
 {
-    return val_smc_call(RMI_PDEV_NOTIFY, pdev_ptr, ev, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_PDEV_NOTIFY, pdev_ptr, ev, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -789,7 +984,7 @@ val_smc_param_ts val_host_rmi_pdev_notify(uint64_t pdev_ptr, uint64_t ev)
 val_smc_param_ts val_host_rmi_pdev_set_key(uint64_t pdev_ptr, uint64_t key,
                                                 uint64_t len, uint8_t algo)
 {
-    return val_smc_call(RMI_PDEV_SET_KEY, pdev_ptr, key, len, algo, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_PDEV_SET_KEY, pdev_ptr, key, len, algo, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -799,7 +994,7 @@ val_smc_param_ts val_host_rmi_pdev_set_key(uint64_t pdev_ptr, uint64_t key,
 **/
 val_smc_param_ts val_host_rmi_pdev_stop(uint64_t pdev_ptr)
 {
-    return val_smc_call(RMI_PDEV_STOP, pdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_PDEV_STOP, pdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -809,7 +1004,7 @@ val_smc_param_ts val_host_rmi_pdev_stop(uint64_t pdev_ptr)
 **/
 val_smc_param_ts val_host_rmi_vdev_abort(uint64_t vdev_ptr)
 {
-    return val_smc_call(RMI_VDEV_ABORT, vdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_VDEV_ABORT, vdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -820,7 +1015,7 @@ val_smc_param_ts val_host_rmi_vdev_abort(uint64_t vdev_ptr)
 **/
 val_smc_param_ts val_host_rmi_vdev_communicate(uint64_t vdev_ptr, uint64_t data_ptr)
 {
-    return val_smc_call(RMI_VDEV_COMMUNICATE, vdev_ptr, data_ptr, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_VDEV_COMMUNICATE, vdev_ptr, data_ptr, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -834,7 +1029,7 @@ val_smc_param_ts val_host_rmi_vdev_communicate(uint64_t vdev_ptr, uint64_t data_
 val_smc_param_ts val_host_rmi_vdev_create(uint64_t rd, uint64_t pdev_ptr,
                                   uint64_t vdev_ptr, uint64_t params_ptr)
 {
-    return val_smc_call(RMI_VDEV_CREATE, rd, pdev_ptr, vdev_ptr, params_ptr, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_VDEV_CREATE, rd, pdev_ptr, vdev_ptr, params_ptr, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -844,7 +1039,7 @@ val_smc_param_ts val_host_rmi_vdev_create(uint64_t rd, uint64_t pdev_ptr,
 **/
 val_smc_param_ts val_host_rmi_vdev_destroy(uint64_t vdev_ptr)
 {
-    return val_smc_call(RMI_VDEV_DESTROY, vdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_VDEV_DESTROY, vdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -855,7 +1050,7 @@ val_smc_param_ts val_host_rmi_vdev_destroy(uint64_t vdev_ptr)
 **/
 val_smc_param_ts val_host_rmi_vdev_get_state(uint64_t vdev_ptr)
 {
-    return val_smc_call(RMI_VDEV_GET_STATE, vdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_VDEV_GET_STATE, vdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -865,7 +1060,7 @@ val_smc_param_ts val_host_rmi_vdev_get_state(uint64_t vdev_ptr)
 **/
 val_smc_param_ts val_host_rmi_vdev_stop(uint64_t vdev_ptr)
 {
-    return val_smc_call(RMI_VDEV_STOP, vdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_VDEV_STOP, vdev_ptr, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -875,7 +1070,7 @@ val_smc_param_ts val_host_rmi_vdev_stop(uint64_t vdev_ptr)
 **/
 val_smc_param_ts val_host_rmi_mec_set_private(uint64_t mecid)
 {
-    return val_smc_call(RMI_MEC_SET_PRIVATE, mecid, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_MEC_SET_PRIVATE, mecid, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
 
 /**
@@ -885,5 +1080,5 @@ val_smc_param_ts val_host_rmi_mec_set_private(uint64_t mecid)
 **/
 val_smc_param_ts val_host_rmi_mec_set_shared(uint64_t mecid)
 {
-    return val_smc_call(RMI_MEC_SET_SHARED, mecid, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    return val_host_rmi_call(RMI_MEC_SET_SHARED, mecid, 0, 0, 0, 0, 0, 0, 0, 0, 0);
 }
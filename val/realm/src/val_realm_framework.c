@@ -16,6 +16,7 @@
 
 extern uint64_t realm_ipa_width;
 extern uint64_t val_image_load_offset;
+extern const uint32_t  total_tests;
 extern const test_db_t test_list[];
 extern bool realm_in_p0;
 extern bool realm_in_pn;
@@ -69,6 +70,29 @@ void val_realm_return_to_host(void)
     //val_return_to_host_hvc_asm();
 }
 
+/**
+ *   @brief    Finds current test index. The test number set by the host is
+ *             used when this image holds the current test at that index,
+ *             else the test is looked up by name.
+ *   @param    void
+ *   @return   Test index, total_tests if the test is not in this image
+**/
+static uint32_t val_realm_find_current_test_index(void)
+{
+    uint32_t          index = val_get_curr_test_num();
+
+    if (index < total_tests && !val_is_current_test((char *)test_list[index].test_name))
+        return index;
+
+    for (index = 1; index < total_tests; index++)
+    {
+        if (!val_is_current_test((char *)test_list[index].test_name))
+            return index;
+    }
+
+    return total_tests;
+}
+
 /**
  *   @brief    Query test database and execute test from each suite one by one
  *   @param    void
@@ -77,11 +101,20 @@ void val_realm_return_to_host(void)
 static void val_realm_test_dispatch(void)
 {
     test_fptr_t       fn_ptr;
+    uint32_t          index = val_realm_find_current_test_index();
+
+    if (index >= total_tests)
+    {
+        LOG(ERROR, "Current test not found in realm test list\n", 0, 0);
+        val_printf_flush();
+        pal_terminate_simulation();
+    }
 
-    fn_ptr = (test_fptr_t)(test_list[val_get_curr_test_num()].realm_fn);
+    fn_ptr = (test_fptr_t)(test_list[index].realm_fn);
     if (fn_ptr == NULL)
     {
         LOG(ERROR, "Invalid realm test address\n", 0, 0);
+        val_printf_flush();
         pal_terminate_simulation();
     }
 
@@ -172,5 +205,6 @@ void val_realm_main(bool primary_cpu_boot)
 
 shutdown:
     LOG(ALWAYS, "REALM : Entering standby.. \n", 0, 0);
+    val_printf_flush();
     pal_terminate_simulation();
 }
@@ -44,22 +44,28 @@ uint32_t val_secure_return_to_preempted_host(void)
 }
 
 /**
- *   @brief    Finds current test index
+ *   @brief    Finds current test index. The secure image always holds the
+ *             combined list, so the test number set by the host is only used
+ *             when the entry at that index is the current test, else the
+ *             test is looked up by name.
  *   @param    void
- *   @return   0
+ *   @return   Test index
 **/
 static uint32_t val_secure_find_current_test_index(void)
 {
-    uint32_t          index;
+    uint32_t          index = val_get_curr_test_num();
+
+    if (index != 0 && index < total_tests &&
+        !val_is_current_test((char *)test_list[index].test_name))
+        return index;
 
     for (index = 1; index < total_tests ; index++)
     {
         /* Is this the current test */
-        if (!val_is_current_test((void *)test_list[index].test_name))
+        if (!val_is_current_test((char *)test_list[index].test_name))
             return index;
-        else
-            continue;
     }
+
     VAL_PANIC("No valid secure test found, something went wrong\n");
     return 0;
 }